@@ -0,0 +1,254 @@
+/**
+ * @file bench.cc
+ *
+ * @file utility.h
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pg/cpp/utils/benchmark.h"
+#include "pg/cpp/utils/exception.h"
+#include "pg/cpp/utils/versioning.h"
+#include "pg/cpp/utils/icu_data.h"
+
+#include "jsoncpp/json.h"
+
+#include <unicode/uclean.h> // u_setMemoryFunctions
+#include <unicode/uversion.h>
+
+#include <openssl/crypto.h>
+#include <openssl/opensslv.h>
+
+#include <new>      // std::bad_alloc
+#include <iostream> // std::cout, std::cerr
+#include <fstream>  // std::ofstream
+
+#include <stdlib.h> // malloc, realloc, free
+#include <getopt.h> // getopt
+
+/*
+ * Allocation accounting: C++ heap, ICU and OpenSSL calls are all counted,
+ * palloc calls are counted by the memory context stub.
+ *
+ * The replacement operators are kept out of line: inlined, GCC pairs the
+ * malloc / free they wrap with new / delete expressions and warns
+ * ( -Wmismatched-new-delete ).
+ */
+static uint64_t s_allocations_ = 0;
+static uint64_t s_bytes_       = 0;
+
+__attribute__((noinline)) void* operator new (size_t a_size)
+{
+    s_allocations_ += 1;
+    s_bytes_       += a_size;
+    void* rv = malloc(a_size);
+    if ( nullptr == rv ) {
+        throw std::bad_alloc();
+    }
+    return rv;
+}
+
+__attribute__((noinline)) void* operator new[] (size_t a_size)
+{
+    return operator new(a_size);
+}
+
+__attribute__((noinline)) void operator delete (void* a_pointer) noexcept
+{
+    free(a_pointer);
+}
+
+__attribute__((noinline)) void operator delete[] (void* a_pointer) noexcept
+{
+    free(a_pointer);
+}
+
+static void* CountedAlloc (size_t a_size)
+{
+    s_allocations_ += 1;
+    s_bytes_       += a_size;
+    return malloc(a_size);
+}
+
+static void* CountedRealloc (void* a_pointer, size_t a_size)
+{
+    s_allocations_ += 1;
+    s_bytes_       += a_size;
+    return realloc(a_pointer, a_size);
+}
+
+static void* ICUAlloc (const void* /* a_context */, size_t a_size)
+{
+    return CountedAlloc(a_size);
+}
+
+static void* ICURealloc (const void* /* a_context */, void* a_pointer, size_t a_size)
+{
+    return CountedRealloc(a_pointer, a_size);
+}
+
+static void ICUFree (const void* /* a_context */, void* a_pointer)
+{
+    free(a_pointer);
+}
+
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+static void* OpenSSLAlloc (size_t a_size, const char* /* a_file */, int /* a_line */)
+{
+    return CountedAlloc(a_size);
+}
+
+static void* OpenSSLRealloc (void* a_pointer, size_t a_size, const char* /* a_file */, int /* a_line */)
+{
+    return CountedRealloc(a_pointer, a_size);
+}
+
+static void OpenSSLFree (void* a_pointer, const char* /* a_file */, int /* a_line */)
+{
+    free(a_pointer);
+}
+#else
+static void OpenSSLFree (void* a_pointer)
+{
+    free(a_pointer);
+}
+#endif
+
+static bool SetICUMemoryFunctions ()
+{
+    UErrorCode icu_error_code = U_ZERO_ERROR;
+    u_setMemoryFunctions(nullptr, ICUAlloc, ICURealloc, ICUFree, &icu_error_code);
+    if ( U_FAILURE(icu_error_code) ) {
+        std::cerr << "Unable to set ICU memory functions: " << u_errorName(icu_error_code) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static void ShowUsage (const char* const a_name)
+{
+    std::cerr << "usage: " << a_name << " [-u <utility>] [-i <iterations>] [-o <json file>] [-d <icu data package>]" << std::endl;
+    std::cerr << "  utilities: *";
+    for ( auto name : pg::cpp::utils::Benchmark::Utilities() ) {
+        std::cerr << ", " << name;
+    }
+    std::cerr << std::endl;
+}
+
+/**
+ * @brief Standalone micro-benchmark, results written as JSON.
+ */
+int main (int a_argc, char** a_argv)
+{
+    std::string utility    = "*";
+    size_t      iterations = 1000;
+    std::string output;
+    std::string icu_data;
+
+    int opt;
+    while ( -1 != ( opt = getopt(a_argc, a_argv, "u:i:o:d:h") ) ) {
+        switch ( opt ) {
+            case 'u':
+                utility = optarg;
+                break;
+            case 'i':
+                iterations = static_cast<size_t>(strtoull(optarg, nullptr, 10));
+                break;
+            case 'o':
+                output = optarg;
+                break;
+            case 'd':
+                icu_data = optarg;
+                break;
+            default:
+                ShowUsage(a_argv[0]);
+                return 'h' == opt ? 0 : -1;
+        }
+    }
+
+    // ... hooks must be installed before ICU or OpenSSL allocate anything ...
+    if ( false == SetICUMemoryFunctions() ) {
+        return -1;
+    }
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+    if ( 1 != CRYPTO_set_mem_functions(OpenSSLAlloc, OpenSSLRealloc, OpenSSLFree) ) {
+#else
+    if ( 1 != CRYPTO_set_mem_functions(CountedAlloc, CountedRealloc, OpenSSLFree) ) {
+#endif
+        std::cerr << "Unable to set OpenSSL memory functions!" << std::endl;
+        return -1;
+    }
+
+    // ... before ICU loads any data ...
+    if ( 0 != icu_data.length() ) {
+        pg::cpp::utils::Status status;
+        if ( false == pg::cpp::utils::ICUData::Load(icu_data.c_str(), status) ) {
+            std::cerr << status.Message() << std::endl;
+            return -1;
+        }
+    }
+
+    std::vector<pg::cpp::utils::Benchmark::Result> results;
+    try {
+        pg::cpp::utils::Benchmark benchmark([] (uint64_t& o_allocations, uint64_t& o_bytes) {
+            o_allocations = s_allocations_ + pg_cpp_utils_stub_palloc_calls;
+            o_bytes       = s_bytes_;
+        });
+        benchmark.Run(utility, iterations);
+        results = benchmark.Results();
+    } catch (const pg::cpp::utils::Exception& a_exception) {
+        std::cerr << a_exception.what() << std::endl;
+        return -1;
+    }
+
+    pg::Json::Value report = pg::Json::Value(pg::Json::ValueType::objectValue);
+    report["version"]    = PG_CPP_UTILS_VERSION;
+    report["icu"]        = U_ICU_VERSION;
+    report["icu_data"]   = 0 != icu_data.length() ? icu_data : "built-in";
+    report["openssl"]    = OPENSSL_VERSION_TEXT;
+    report["iterations"] = static_cast<pg::Json::UInt64>(iterations);
+    report["results"]    = pg::Json::Value(pg::Json::ValueType::arrayValue);
+    for ( auto& result : results ) {
+        pg::Json::Value entry = pg::Json::Value(pg::Json::ValueType::objectValue);
+        entry["utility"]             = result.utility_;
+        entry["input"]               = result.input_;
+        entry["ns_per_op"]           = static_cast<double>(result.total_ns_) / result.iterations_;
+        entry["ops_per_sec"]         = result.total_ns_ > 0 ? ( 1e9 * result.iterations_ ) / result.total_ns_ : 0.0;
+        entry["p50_ns"]              = static_cast<pg::Json::UInt64>(result.p50_ns_);
+        entry["p99_ns"]              = static_cast<pg::Json::UInt64>(result.p99_ns_);
+        entry["allocations_per_op"]  = static_cast<double>(result.allocations_) / result.iterations_;
+        entry["bytes_per_op"]        = static_cast<double>(result.bytes_allocated_) / result.iterations_;
+        entry["palloc_bytes_per_op"] = static_cast<double>(result.palloc_bytes_) / result.iterations_;
+        entry["rss_growth_bytes"]    = static_cast<pg::Json::Int64>(result.rss_growth_);
+        report["results"].append(entry);
+    }
+
+    pg::Json::StyledWriter writer;
+    if ( 0 == output.length() ) {
+        std::cout << writer.write(report);
+    } else {
+        std::ofstream file(output);
+        file << writer.write(report);
+        if ( false == file.good() ) {
+            std::cerr << "Unable to write '" << output << "'!" << std::endl;
+            return -1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,59 @@
+/**
+ * @file port/atomics.h
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "server/postgres.h"
+
+/*
+ * The benchmark is single threaded, plain loads and stores are enough.
+ */
+typedef struct pg_atomic_uint64
+{
+    volatile uint64 value;
+} pg_atomic_uint64;
+
+static inline void pg_atomic_init_u64 (pg_atomic_uint64* a_ptr, uint64 a_value)
+{
+    a_ptr->value = a_value;
+}
+
+static inline uint64 pg_atomic_read_u64 (pg_atomic_uint64* a_ptr)
+{
+    return a_ptr->value;
+}
+
+static inline uint64 pg_atomic_fetch_add_u64 (pg_atomic_uint64* a_ptr, int64 a_add)
+{
+    const uint64 old = a_ptr->value;
+    a_ptr->value = old + (uint64) a_add;
+    return old;
+}
+
+static inline bool pg_atomic_compare_exchange_u64 (pg_atomic_uint64* a_ptr, uint64* a_expected, uint64 a_new)
+{
+    if ( a_ptr->value == *a_expected ) {
+        a_ptr->value = a_new;
+        return true;
+    }
+    *a_expected = a_ptr->value;
+    return false;
+}
@@ -0,0 +1,299 @@
+/**
+ * @file postgres.cc
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+extern "C" {
+    #include "server/postgres.h"
+    #include "utils/memutils.h"
+    #include "miscadmin.h"
+    #include "storage/ipc.h"
+    #include "storage/shmem.h"
+    #include "storage/lwlock.h"
+}
+
+#include <stdlib.h> // malloc, free, abort
+#include <stdarg.h> // va_list
+#include <new>      // std::bad_alloc
+#include <vector>   // std::vector
+#include <algorithm>
+
+/*
+ * A naive memory context: every chunk is malloc'ed with a header and linked
+ * to its owner, so that reset / delete release everything in one go - which
+ * is the behaviour the pg::cpp::utils classes rely on.
+ */
+struct MemoryContextData
+{
+    MemoryContextData*              parent_;
+    std::vector<MemoryContextData*> children_;
+    struct Chunk*                   head_;
+    Size                            allocated_;
+};
+
+typedef struct Chunk
+{
+    alignas(16) struct Chunk* prev_;
+    struct Chunk*             next_;
+    MemoryContextData*        owner_;
+    Size                      size_;
+} Chunk;
+
+static MemoryContextData s_top_memory_context_ = { nullptr, {}, nullptr, 0 };
+
+MemoryContext CurrentMemoryContext = &s_top_memory_context_;
+MemoryContext TopMemoryContext     = &s_top_memory_context_;
+
+uint64_t pg_cpp_utils_stub_palloc_calls = 0;
+
+static void ReleaseChunks (MemoryContextData* a_context)
+{
+    Chunk* chunk = a_context->head_;
+    while ( nullptr != chunk ) {
+        Chunk* next = chunk->next_;
+        free(chunk);
+        chunk = next;
+    }
+    a_context->head_      = nullptr;
+    a_context->allocated_ = 0;
+}
+
+void* MemoryContextAlloc (MemoryContext a_context, Size a_size)
+{
+    Chunk* chunk = static_cast<Chunk*>(malloc(sizeof(Chunk) + a_size));
+    if ( nullptr == chunk ) {
+        throw std::bad_alloc();
+    }
+    chunk->prev_  = nullptr;
+    chunk->next_  = a_context->head_;
+    chunk->owner_ = a_context;
+    chunk->size_  = a_size;
+    if ( nullptr != a_context->head_ ) {
+        a_context->head_->prev_ = chunk;
+    }
+    a_context->head_       = chunk;
+    a_context->allocated_ += a_size;
+    pg_cpp_utils_stub_palloc_calls += 1;
+    return chunk + 1;
+}
+
+void* palloc (Size a_size)
+{
+    return MemoryContextAlloc(CurrentMemoryContext, a_size);
+}
+
+void* palloc0 (Size a_size)
+{
+    void* rv = palloc(a_size);
+    memset(rv, 0, a_size);
+    return rv;
+}
+
+void pfree (void* a_pointer)
+{
+    Chunk*             chunk   = static_cast<Chunk*>(a_pointer) - 1;
+    MemoryContextData* context = chunk->owner_;
+    if ( nullptr != chunk->prev_ ) {
+        chunk->prev_->next_ = chunk->next_;
+    } else {
+        context->head_ = chunk->next_;
+    }
+    if ( nullptr != chunk->next_ ) {
+        chunk->next_->prev_ = chunk->prev_;
+    }
+    context->allocated_ -= chunk->size_;
+    free(chunk);
+}
+
+void* repalloc (void* a_pointer, Size a_size)
+{
+    const Chunk* chunk = static_cast<Chunk*>(a_pointer) - 1;
+    void*        rv    = MemoryContextAlloc(chunk->owner_, a_size);
+    memcpy(rv, a_pointer, std::min(chunk->size_, a_size));
+    pfree(a_pointer);
+    return rv;
+}
+
+MemoryContext AllocSetContextCreateInternal (MemoryContext a_parent, const char* /* a_name */,
+                                             Size /* a_min_context_size */, Size /* a_init_block_size */, Size /* a_max_block_size */)
+{
+    MemoryContextData* context = new MemoryContextData { a_parent, {}, nullptr, 0 };
+    a_parent->children_.push_back(context);
+    return context;
+}
+
+void MemoryContextReset (MemoryContext a_context)
+{
+    while ( false == a_context->children_.empty() ) {
+        MemoryContextDelete(a_context->children_.back());
+    }
+    ReleaseChunks(a_context);
+}
+
+void MemoryContextDelete (MemoryContext a_context)
+{
+    MemoryContextReset(a_context);
+    if ( nullptr != a_context->parent_ ) {
+        auto& siblings = a_context->parent_->children_;
+        siblings.erase(std::remove(siblings.begin(), siblings.end(), a_context), siblings.end());
+    }
+    if ( CurrentMemoryContext == a_context ) {
+        CurrentMemoryContext = a_context->parent_;
+    }
+    delete a_context;
+}
+
+Size MemoryContextMemAllocated (MemoryContext a_context, bool a_recurse)
+{
+    Size rv = a_context->allocated_;
+    if ( true == a_recurse ) {
+        for ( auto child : a_context->children_ ) {
+            rv += MemoryContextMemAllocated(child, true);
+        }
+    }
+    return rv;
+}
+
+/*
+ * Shared memory: never preloaded, so the hooks are never called.
+ */
+bool                    process_shared_preload_libraries_in_progress = false;
+shmem_startup_hook_type shmem_startup_hook                           = nullptr;
+shmem_request_hook_type shmem_request_hook                           = nullptr;
+LWLock*                 AddinShmemInitLock                           = nullptr;
+
+void* ShmemInitStruct (const char* /* a_name */, Size a_size, bool* o_found)
+{
+    *o_found = false;
+    return calloc(1, a_size);
+}
+
+void RequestAddinShmemSpace (Size /* a_size */)
+{
+    /* empty */
+}
+
+bool LWLockAcquire (LWLock* /* a_lock */, LWLockMode /* a_mode */)
+{
+    return true;
+}
+
+void LWLockRelease (LWLock* /* a_lock */)
+{
+    /* empty */
+}
+
+/*
+ * Errors: a single error being reported at a time, as in elog.c's errordata stack
+ * with depth 1 - enough for ErrorBridge's copy, flush and re-throw.
+ */
+sigjmp_buf* PG_exception_stack = nullptr;
+
+static ErrorData s_error_data_ = { 0, 0, nullptr };
+
+void errstart (int a_elevel)
+{
+    FlushErrorState();
+    s_error_data_.elevel     = a_elevel;
+    s_error_data_.sqlerrcode = ERRCODE_FEATURE_NOT_SUPPORTED;
+}
+
+void errfinish (void)
+{
+    if ( s_error_data_.elevel >= ERROR ) {
+        pg_re_throw();
+    }
+    FlushErrorState();
+}
+
+int errcode (int a_sqlerrcode)
+{
+    s_error_data_.sqlerrcode = a_sqlerrcode;
+    return 0;
+}
+
+int errmsg (const char* a_format, ...)
+{
+    va_list args;
+    va_start(args, a_format);
+    const int length = vsnprintf(nullptr, 0, a_format, args);
+    va_end(args);
+
+    free(s_error_data_.message);
+    s_error_data_.message = static_cast<char*>(malloc(static_cast<size_t>(length) + 1));
+    va_start(args, a_format);
+    (void)vsnprintf(s_error_data_.message, static_cast<size_t>(length) + 1, a_format, args);
+    va_end(args);
+    return 0;
+}
+
+void pg_re_throw (void)
+{
+    if ( nullptr == PG_exception_stack ) {
+        fprintf(stderr, "ERROR: %s\n", nullptr != s_error_data_.message ? s_error_data_.message : "");
+        abort();
+    }
+    siglongjmp(*PG_exception_stack, 1);
+}
+
+ErrorData* CopyErrorData (void)
+{
+    ErrorData* copy = static_cast<ErrorData*>(palloc(sizeof(ErrorData)));
+    *copy = s_error_data_;
+    if ( nullptr != s_error_data_.message ) {
+        const size_t length = strlen(s_error_data_.message);
+        copy->message = static_cast<char*>(palloc(length + 1));
+        memcpy(copy->message, s_error_data_.message, length + 1);
+    }
+    return copy;
+}
+
+void FreeErrorData (ErrorData* a_data)
+{
+    if ( nullptr != a_data->message ) {
+        pfree(a_data->message);
+    }
+    pfree(a_data);
+}
+
+void FlushErrorState (void)
+{
+    free(s_error_data_.message);
+    s_error_data_ = { 0, 0, nullptr };
+}
+
+void ReThrowError (ErrorData* a_data)
+{
+    errstart(a_data->elevel);
+    errcode(a_data->sqlerrcode);
+    errmsg("%s", nullptr != a_data->message ? a_data->message : "");
+    pg_re_throw();
+}
+
+void* MemoryContextAllocExtended (MemoryContext a_context, Size a_size, int a_flags)
+{
+    try {
+        return MemoryContextAlloc(a_context, a_size);
+    } catch (const std::bad_alloc&) {
+        if ( 0 != ( a_flags & MCXT_ALLOC_NO_OOM ) ) {
+            return nullptr;
+        }
+        throw;
+    }
+}
@@ -0,0 +1,132 @@
+/**
+ * @file postgres.h
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/*
+ * Minimal stand-in for the PostgreSQL server headers, so that the
+ * pg::cpp::utils classes can be linked into a standalone benchmark.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+
+#define PG_VERSION_NUM 150000
+
+typedef size_t    Size;
+typedef uintptr_t Datum;
+typedef int32_t   int32;
+typedef int64_t   int64;
+typedef uint64_t  uint64;
+
+#define MAXALIGN(a_length) ( ( (uintptr_t) (a_length) + 7 ) & ~( (uintptr_t) 7 ) )
+
+typedef struct MemoryContextData* MemoryContext;
+
+extern MemoryContext CurrentMemoryContext;
+extern MemoryContext TopMemoryContext;
+
+extern void* MemoryContextAlloc (MemoryContext a_context, Size a_size);
+extern void* palloc             (Size a_size);
+extern void* palloc0            (Size a_size);
+extern void* repalloc           (void* a_pointer, Size a_size);
+extern void  pfree              (void* a_pointer);
+
+static inline MemoryContext MemoryContextSwitchTo (MemoryContext a_context)
+{
+    MemoryContext old = CurrentMemoryContext;
+    CurrentMemoryContext = a_context;
+    return old;
+}
+
+/*
+ * Stub only: number of palloc calls, read by the benchmark allocation probe.
+ */
+extern uint64_t pg_cpp_utils_stub_palloc_calls;
+
+/*
+ * Errors: ereport longjmps to the innermost PG_TRY, as elog.c does - so that
+ * pg::cpp::utils::ErrorBridge can be measured outside a backend.
+ */
+#include <setjmp.h>
+
+#define DEBUG3 10
+#define ERROR  21
+
+#define PGSIXBIT(a_ch)                                 ( ( (a_ch) - '0' ) & 0x3F )
+#define MAKE_SQLSTATE(a_ch1, a_ch2, a_ch3, a_ch4, a_ch5) \
+    ( PGSIXBIT(a_ch1) + ( PGSIXBIT(a_ch2) << 6 ) + ( PGSIXBIT(a_ch3) << 12 ) + ( PGSIXBIT(a_ch4) << 18 ) + ( PGSIXBIT(a_ch5) << 24 ) )
+
+#define ERRCODE_FEATURE_NOT_SUPPORTED   MAKE_SQLSTATE('0','A','0','0','0')
+#define ERRCODE_INVALID_PARAMETER_VALUE MAKE_SQLSTATE('2','2','0','2','3')
+#define ERRCODE_OUT_OF_MEMORY           MAKE_SQLSTATE('5','3','2','0','0')
+
+typedef struct ErrorData
+{
+    int   elevel;
+    int   sqlerrcode;
+    char* message;
+} ErrorData;
+
+extern sigjmp_buf* PG_exception_stack;
+
+#define PG_TRY() \
+    do { \
+        sigjmp_buf* save_exception_stack = PG_exception_stack; \
+        sigjmp_buf  local_sigjmp_buf; \
+        if ( 0 == sigsetjmp(local_sigjmp_buf, 0) ) { \
+            PG_exception_stack = &local_sigjmp_buf
+
+#define PG_CATCH() \
+        } else { \
+            PG_exception_stack = save_exception_stack
+
+#define PG_END_TRY() \
+        } \
+        PG_exception_stack = save_exception_stack; \
+    } while (0)
+
+#define PG_RE_THROW() pg_re_throw()
+
+#define ereport(a_elevel, a_rest) \
+    do { \
+        errstart(a_elevel); \
+        (void) a_rest; \
+        errfinish(); \
+    } while (0)
+
+extern void       errstart        (int a_elevel);
+extern void       errfinish       (void);
+extern int        errcode         (int a_sqlerrcode);
+extern int        errmsg          (const char* a_format, ...) __attribute__((format(printf, 1, 2)));
+extern void       pg_re_throw     (void) __attribute__((noreturn));
+extern ErrorData* CopyErrorData   (void);
+extern void       FreeErrorData   (ErrorData* a_data);
+extern void       FlushErrorState (void);
+extern void       ReThrowError    (ErrorData* a_data) __attribute__((noreturn));
+
+#define MCXT_ALLOC_HUGE   0x01
+#define MCXT_ALLOC_NO_OOM 0x02
+
+extern void* MemoryContextAllocExtended (MemoryContext a_context, Size a_size, int a_flags);
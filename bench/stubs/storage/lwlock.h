@@ -0,0 +1,37 @@
+/**
+ * @file storage/lwlock.h
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "server/postgres.h"
+
+typedef struct LWLock LWLock;
+
+typedef enum LWLockMode
+{
+    LW_EXCLUSIVE,
+    LW_SHARED
+} LWLockMode;
+
+extern LWLock* AddinShmemInitLock;
+
+extern bool LWLockAcquire (LWLock* a_lock, LWLockMode a_mode);
+extern void LWLockRelease (LWLock* a_lock);
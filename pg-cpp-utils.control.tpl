@@ -1,5 +1,5 @@
 # pg-cpp-utils extension
 comment = 'C++ PostgreSQL extension module - utilities functions'
-default_version = '@VERSION@'
+default_version = '@SQL_VERSION@'
 module_pathname = '$libdir/pg-cpp-utils'
 relocatable = true
@@ -0,0 +1,252 @@
+--
+-- @file pg-cpp-utils--1.0--1.1.sql
+--
+-- Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+--
+-- This file is part of casper-pg-cpp-utils.
+--
+-- casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+-- it under the terms of the GNU Affero General Public License as published by
+-- the Free Software Foundation, either version 3 of the License, or
+-- (at your option) any later version.
+--
+-- casper-pg-cpp-utils is distributed in the hope that it will be useful,
+-- but WITHOUT ANY WARRANTY; without even the implied warranty of
+-- MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+-- GNU General Public License for more details.
+--
+-- You should have received a copy of the GNU Affero General Public License
+-- along with casper.  If not, see <http://www.gnu.org/licenses/>.
+--
+
+\echo Use "ALTER EXTENSION pg-cpp-utils UPDATE TO '1.1'" to load this file. \quit
+
+CREATE TYPE pg_cpp_utils_bench_record AS (
+  utility         text,
+  input           text,
+  ops_per_sec     float8,
+  p50_ns          bigint,
+  p99_ns          bigint,
+  bytes_allocated bigint,
+  rss_growth      bigint
+);
+
+CREATE FUNCTION pg_cpp_utils_bench (
+  a_utility    text,
+  a_iterations int default 1000
+) RETURNS SETOF pg_cpp_utils_bench_record AS 'MODULE_PATHNAME', 'pg_cpp_utils_bench'
+  LANGUAGE C STRICT VOLATILE COST 1000000 ROWS 3;
+
+CREATE TYPE pg_cpp_utils_stats_record AS (
+  utility      text,
+  calls        bigint,
+  errors       bigint,
+  total_us     bigint,
+  max_us       bigint,
+  mean_us      float8,
+  cache_hits   bigint,
+  cache_misses bigint
+);
+
+CREATE FUNCTION pg_cpp_utils_stats (
+  a_shared boolean default false
+) RETURNS SETOF pg_cpp_utils_stats_record AS 'MODULE_PATHNAME', 'pg_cpp_utils_stats'
+  LANGUAGE C STRICT VOLATILE COST 10 ROWS 17;
+
+CREATE TYPE pg_cpp_utils_cache_record AS (
+  cache     text,
+  entries   bigint,
+  bytes     bigint,
+  hits      bigint,
+  misses    bigint,
+  evictions bigint
+);
+
+CREATE FUNCTION pg_cpp_utils_caches (
+) RETURNS SETOF pg_cpp_utils_cache_record AS 'MODULE_PATHNAME', 'pg_cpp_utils_caches'
+  LANGUAGE C STRICT VOLATILE COST 10 ROWS 4;
+
+CREATE FUNCTION pg_cpp_utils_cache_reset (
+  a_name text default 'all'
+) RETURNS bigint AS 'MODULE_PATHNAME', 'pg_cpp_utils_cache_reset'
+  LANGUAGE C STRICT VOLATILE COST 100;
+
+--
+-- Batches, one row per array element; COST is per row.
+--
+
+CREATE TYPE pg_cpp_utils_number_spellout_batch_record AS (number float8, spellout text);
+
+-- value-per-call, rows are spelled out as they are fetched
+CREATE FUNCTION pg_cpp_utils_number_spellout_batch (
+  a_locale            varchar(5),
+  a_numbers           float8[],
+  a_spellout_override text default '',
+  a_rule_set          text default ''
+) RETURNS SETOF pg_cpp_utils_number_spellout_batch_record AS 'MODULE_PATHNAME', 'pg_cpp_utils_number_spellout_batch'
+  LANGUAGE C STRICT STABLE PARALLEL SAFE COST 2000 ROWS 100;
+
+-- materialized, rows are hashed one at a time into a tuple store
+CREATE FUNCTION pg_cpp_utils_invoice_hash_batch (
+  a_pem_uri  text,
+  a_payloads text[]
+) RETURNS SETOF pg_cpp_utils_hash_record AS 'MODULE_PATHNAME', 'pg_cpp_utils_invoice_hash_batch'
+  LANGUAGE C STRICT STABLE PARALLEL SAFE COST 40000 ROWS 100;
+
+--
+-- Invoice hash verification, a_pem_uri is a PUBLIC KEY or CERTIFICATE PEM file.
+--
+
+CREATE TYPE pg_cpp_utils_hash_verify_record AS (valid boolean);
+
+CREATE FUNCTION pg_cpp_utils_invoice_hash_verify (
+  a_pem_uri   text,
+  a_payload   text,
+  a_long_hash text
+) RETURNS pg_cpp_utils_hash_verify_record AS 'MODULE_PATHNAME', 'pg_cpp_utils_invoice_hash_verify'
+  LANGUAGE C STRICT STABLE PARALLEL SAFE COST 2000;
+
+CREATE FUNCTION pg_cpp_utils_invoice_hash_verify_batch (
+  a_pem_uri     text,
+  a_payloads    text[],
+  a_long_hashes text[]
+) RETURNS SETOF pg_cpp_utils_hash_verify_record AS 'MODULE_PATHNAME', 'pg_cpp_utils_invoice_hash_verify_batch'
+  LANGUAGE C STRICT STABLE PARALLEL SAFE COST 2000 ROWS 100;
+
+--
+-- Invoice hash key material as bytea ( PEM or DER, e.g. from a protected table ), parsed once per backend
+-- and cached by it's SHA-256; text arguments starting with '-----BEGIN' are also taken as PEM key material.
+--
+
+CREATE FUNCTION pg_cpp_utils_invoice_hash (
+  a_key     bytea,
+  a_payload text
+) RETURNS pg_cpp_utils_hash_record AS 'MODULE_PATHNAME', 'pg_cpp_utils_invoice_hash'
+  LANGUAGE C STRICT STABLE PARALLEL SAFE COST 40000;
+
+CREATE FUNCTION pg_cpp_utils_invoice_hash_batch (
+  a_key      bytea,
+  a_payloads text[]
+) RETURNS SETOF pg_cpp_utils_hash_record AS 'MODULE_PATHNAME', 'pg_cpp_utils_invoice_hash_batch'
+  LANGUAGE C STRICT STABLE PARALLEL SAFE COST 40000 ROWS 100;
+
+CREATE FUNCTION pg_cpp_utils_invoice_hash_verify (
+  a_key       bytea,
+  a_payload   text,
+  a_long_hash text
+) RETURNS pg_cpp_utils_hash_verify_record AS 'MODULE_PATHNAME', 'pg_cpp_utils_invoice_hash_verify'
+  LANGUAGE C STRICT STABLE PARALLEL SAFE COST 2000;
+
+CREATE FUNCTION pg_cpp_utils_invoice_hash_verify_batch (
+  a_key         bytea,
+  a_payloads    text[],
+  a_long_hashes text[]
+) RETURNS SETOF pg_cpp_utils_hash_verify_record AS 'MODULE_PATHNAME', 'pg_cpp_utils_invoice_hash_verify_batch'
+  LANGUAGE C STRICT STABLE PARALLEL SAFE COST 2000 ROWS 100;
+
+--
+-- Non-certification signatures: a_algorithm is one of 'rsa-pss-sha256', 'rsa-sha256', 'rsa-sha1' or 'ed25519',
+-- a_key a PEM file path or PEM / DER key material ( as for pg_cpp_utils_invoice_hash ).
+--
+
+CREATE TYPE pg_cpp_utils_signature_record AS (signature text);
+
+CREATE FUNCTION pg_cpp_utils_sign (
+  a_key       text,
+  a_payload   text,
+  a_algorithm text default 'rsa-pss-sha256'
+) RETURNS pg_cpp_utils_signature_record AS 'MODULE_PATHNAME', 'pg_cpp_utils_sign'
+  LANGUAGE C STRICT STABLE PARALLEL SAFE COST 40000;
+
+CREATE FUNCTION pg_cpp_utils_sign (
+  a_key       bytea,
+  a_payload   text,
+  a_algorithm text default 'rsa-pss-sha256'
+) RETURNS pg_cpp_utils_signature_record AS 'MODULE_PATHNAME', 'pg_cpp_utils_sign'
+  LANGUAGE C STRICT STABLE PARALLEL SAFE COST 40000;
+
+CREATE FUNCTION pg_cpp_utils_sign_verify (
+  a_key       text,
+  a_payload   text,
+  a_signature text,
+  a_algorithm text default 'rsa-pss-sha256'
+) RETURNS pg_cpp_utils_hash_verify_record AS 'MODULE_PATHNAME', 'pg_cpp_utils_sign_verify'
+  LANGUAGE C STRICT STABLE PARALLEL SAFE COST 2000;
+
+CREATE FUNCTION pg_cpp_utils_sign_verify (
+  a_key       bytea,
+  a_payload   text,
+  a_signature text,
+  a_algorithm text default 'rsa-pss-sha256'
+) RETURNS pg_cpp_utils_hash_verify_record AS 'MODULE_PATHNAME', 'pg_cpp_utils_sign_verify'
+  LANGUAGE C STRICT STABLE PARALLEL SAFE COST 2000;
+
+--
+-- Messages with typed arguments: integers, float4 / float8 and numeric reach ICU as numbers ( plural rules and
+-- {n,number} see real values ), date / timestamp / timestamptz as dates shown in the session's TimeZone, anything
+-- else as it's text output.
+--
+
+CREATE FUNCTION pg_cpp_utils_format_message_typed (
+  a_locale text,
+  a_format text,
+  VARIADIC a_args "any"
+) RETURNS pg_cpp_utils_format_message_record AS 'MODULE_PATHNAME', 'pg_cpp_utils_format_message_typed'
+  LANGUAGE C STRICT STABLE PARALLEL SAFE COST 1000;
+
+--
+-- Named spellout rule sets: an a_spellout_override made only of letters, digits, '_', '.' or '-' is the name of rules
+-- registered for the call's locale ( or it's language ), read once per backend and compiled on first use.
+--
+
+CREATE TABLE pg_cpp_utils_spellout_rules (
+  name   text NOT NULL CHECK (name ~ '^[A-Za-z0-9_.-]{1,63}$'),
+  locale text NOT NULL,
+  rules  text NOT NULL,
+  PRIMARY KEY (name, locale)
+);
+
+SELECT pg_catalog.pg_extension_config_dump('pg_cpp_utils_spellout_rules', '');
+
+CREATE FUNCTION pg_cpp_utils_spellout_rules_invalidate (
+) RETURNS trigger AS 'MODULE_PATHNAME', 'pg_cpp_utils_spellout_rules_invalidate'
+  LANGUAGE C;
+
+CREATE TRIGGER pg_cpp_utils_spellout_rules_invalidate
+  AFTER INSERT OR UPDATE OR DELETE OR TRUNCATE ON pg_cpp_utils_spellout_rules
+  FOR EACH STATEMENT EXECUTE PROCEDURE pg_cpp_utils_spellout_rules_invalidate();
+
+CREATE FUNCTION pg_cpp_utils_register_spellout_rules (
+  a_name   text,
+  a_locale text,
+  a_rules  text
+) RETURNS void AS 'MODULE_PATHNAME', 'pg_cpp_utils_register_spellout_rules'
+  LANGUAGE C STRICT VOLATILE COST 40000;
+
+--
+-- Rule set selection: a_rule_set picks one of the formatter's public rule sets ( e.g. %spellout-ordinal-feminine ),
+-- empty for the default one. Added as overloads, without defaults, so the 1.0 functions - and what depends on them -
+-- are kept as they are.
+--
+
+CREATE FUNCTION pg_cpp_utils_number_spellout (
+  a_locale            varchar(5),
+  a_payload           float8,
+  a_spellout_override text,
+  a_rule_set          text
+) RETURNS pg_cpp_utils_number_spellout_record AS 'MODULE_PATHNAME', 'pg_cpp_utils_number_spellout'
+  LANGUAGE C STRICT STABLE PARALLEL SAFE COST 2000;
+
+CREATE FUNCTION pg_cpp_utils_currency_spellout (
+  a_locale            varchar(5),
+  a_major             float8,
+  a_major_singular    text,
+  a_major_plural      text,
+  a_minor             float8,
+  a_minor_singular    text,
+  a_minor_plural      text,
+  a_format            text,
+  a_spellout_override text,
+  a_rule_set          text
+) RETURNS pg_cpp_utils_number_spellout_record AS 'MODULE_PATHNAME', 'pg_cpp_utils_currency_spellout'
+  LANGUAGE C STRICT STABLE PARALLEL SAFE COST 4000;
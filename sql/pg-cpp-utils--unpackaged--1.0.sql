@@ -0,0 +1,48 @@
+--
+-- @file pg-cpp-utils--unpackaged--1.0.sql
+--
+-- Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+--
+-- This file is part of casper-pg-cpp-utils.
+--
+-- casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+-- it under the terms of the GNU Affero General Public License as published by
+-- the Free Software Foundation, either version 3 of the License, or
+-- (at your option) any later version.
+--
+-- casper-pg-cpp-utils is distributed in the hope that it will be useful,
+-- but WITHOUT ANY WARRANTY; without even the implied warranty of
+-- MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+-- GNU General Public License for more details.
+--
+-- You should have received a copy of the GNU Affero General Public License
+-- along with casper.  If not, see <http://www.gnu.org/licenses/>.
+--
+-- Adopts the objects created by hand from README.md into the extension,
+-- without dropping them, so type and function OIDs ( and plans ) survive.
+--
+
+\echo Use "ALTER EXTENSION pg-cpp-utils UPDATE TO '1.0'" to load this file. \quit
+
+ALTER EXTENSION "pg-cpp-utils" ADD TYPE pg_cpp_utils_version_record;
+ALTER EXTENSION "pg-cpp-utils" ADD TYPE pg_cpp_utils_hash_record;
+ALTER EXTENSION "pg-cpp-utils" ADD TYPE pg_cpp_utils_public_link_record;
+ALTER EXTENSION "pg-cpp-utils" ADD TYPE pg_cpp_utils_number_spellout_record;
+ALTER EXTENSION "pg-cpp-utils" ADD TYPE pg_cpp_utils_format_number_record;
+ALTER EXTENSION "pg-cpp-utils" ADD TYPE pg_cpp_utils_format_message_record;
+
+ALTER EXTENSION "pg-cpp-utils" ADD FUNCTION pg_cpp_utils_version ();
+ALTER EXTENSION "pg-cpp-utils" ADD FUNCTION pg_cpp_utils_invoice_hash (text, text);
+ALTER EXTENSION "pg-cpp-utils" ADD FUNCTION pg_cpp_utils_public_link (text, float8, text, float8, text, text);
+ALTER EXTENSION "pg-cpp-utils" ADD FUNCTION pg_cpp_utils_number_spellout (varchar, float8, text);
+ALTER EXTENSION "pg-cpp-utils" ADD FUNCTION pg_cpp_utils_currency_spellout (varchar, float8, text, text, float8, text, text, text, text);
+ALTER EXTENSION "pg-cpp-utils" ADD FUNCTION pg_cpp_utils_format_number (varchar, float8, text);
+ALTER EXTENSION "pg-cpp-utils" ADD FUNCTION pg_cpp_utils_format_message (varchar, varchar, text[]);
+
+ALTER FUNCTION pg_cpp_utils_version () STABLE PARALLEL SAFE COST 10;
+ALTER FUNCTION pg_cpp_utils_invoice_hash (text, text) STABLE PARALLEL SAFE COST 40000;
+ALTER FUNCTION pg_cpp_utils_public_link (text, float8, text, float8, text, text) VOLATILE PARALLEL SAFE COST 400;
+ALTER FUNCTION pg_cpp_utils_number_spellout (varchar, float8, text) STABLE PARALLEL SAFE COST 2000;
+ALTER FUNCTION pg_cpp_utils_currency_spellout (varchar, float8, text, text, float8, text, text, text, text) STABLE PARALLEL SAFE COST 4000;
+ALTER FUNCTION pg_cpp_utils_format_number (varchar, float8, text) STABLE PARALLEL SAFE COST 1000;
+ALTER FUNCTION pg_cpp_utils_format_message (varchar, varchar, text[]) STABLE PARALLEL SAFE COST 1000;
@@ -0,0 +1,28 @@
+--
+-- @file pg-cpp-utils--unpackaged.sql
+--
+-- Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+--
+-- This file is part of casper-pg-cpp-utils.
+--
+-- casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+-- it under the terms of the GNU Affero General Public License as published by
+-- the Free Software Foundation, either version 3 of the License, or
+-- (at your option) any later version.
+--
+-- casper-pg-cpp-utils is distributed in the hope that it will be useful,
+-- but WITHOUT ANY WARRANTY; without even the implied warranty of
+-- MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+-- GNU General Public License for more details.
+--
+-- You should have received a copy of the GNU Affero General Public License
+-- along with casper.  If not, see <http://www.gnu.org/licenses/>.
+--
+-- Empty 'unpackaged' version, for databases where the types and functions
+-- were created by hand ( see README.md ):
+--
+--   CREATE EXTENSION "pg-cpp-utils" VERSION 'unpackaged';
+--   ALTER EXTENSION "pg-cpp-utils" UPDATE;
+--
+
+\echo Use "CREATE EXTENSION pg-cpp-utils VERSION 'unpackaged'" to load this file. \quit
@@ -23,36 +23,86 @@ extern "C" {
     #include "pg/postgres.h"
     #include "access/tupmacs.h"
     #include "utils/builtins.h"
+    #include "utils/memutils.h"    // AllocSetContextCreate
+    #include "utils/tuplestore.h"  // tuplestore_begin_heap
+    #include "miscadmin.h"         // work_mem
+    #include "utils/guc.h"         // DefineCustomIntVariable
+    #include "utils/lsyscache.h"   // get_typlenbyvalalign, getTypeOutputInfo
+    #include "utils/date.h"        // DateADT
+    #include "utils/timestamp.h"   // Timestamp
+    #include "utils/inval.h"       // CacheRegisterRelcacheCallback, CacheInvalidateRelcache
+    #include "executor/spi.h"      // SPI_connect
+    #include "executor/executor.h" // RegisterExprContextCallback
+    #include "commands/trigger.h"  // CALLED_AS_TRIGGER
+    #include "lib/stringinfo.h"    // StringInfoData
 }
 
 #include <inttypes.h>
 
 // C++ headers
 #include <string>
+#include <vector>
 
 #include "pg/cpp/utils/version.h"
 #include "pg/cpp/utils/exception.h"
+#include "pg/cpp/utils/error_bridge.h"
+#include "pg/cpp/utils/allocator.h"
+#include "pg/cpp/utils/icu_data.h"
+#include "pg/cpp/utils/status.h"
 #include "pg/cpp/utils/invoice_hash.h"
 #include "pg/cpp/utils/public_link.h"
+#include "pg/cpp/utils/signature.h"
 #include "pg/cpp/utils/number_spellout.h"
+#include "pg/cpp/utils/spellout_rules.h"
+#include "pg/cpp/utils/spellout_memo.h"
 #include "pg/cpp/utils/number_formatter.h"
 #include "pg/cpp/utils/message_formatter.h"
+#include "pg/cpp/utils/benchmark.h"
+#include "pg/cpp/utils/stats.h"
+#include "pg/cpp/utils/cache.h"
+#include "pg/cpp/utils/cache_stats.h"
+#include "pg/cpp/utils/string_view.h"
 
-#include <unicode/utypes.h> // u_init
-#include <unicode/uclean.h> // u_cleanup
+#include <unicode/utypes.h> // UErrorCode
+#include <unicode/uclean.h> // u_init
+
+#include <chrono>           // std::chrono
+#include <new>              // placement new
+#include <type_traits>      // std::aligned_storage
+#include <initializer_list> // std::initializer_list
 
 extern "C" {
     PG_MODULE_MAGIC;
+    void _PG_init (void);
     Datum pg_cpp_utils_invoice_hash(PG_FUNCTION_ARGS);
     Datum pg_cpp_utils_number_spellout(PG_FUNCTION_ARGS);
+    Datum pg_cpp_utils_number_spellout_batch(PG_FUNCTION_ARGS);
+    Datum pg_cpp_utils_invoice_hash_batch(PG_FUNCTION_ARGS);
+    Datum pg_cpp_utils_invoice_hash_verify(PG_FUNCTION_ARGS);
+    Datum pg_cpp_utils_invoice_hash_verify_batch(PG_FUNCTION_ARGS);
+    Datum pg_cpp_utils_sign(PG_FUNCTION_ARGS);
+    Datum pg_cpp_utils_sign_verify(PG_FUNCTION_ARGS);
     Datum pg_cpp_utils_version(PG_FUNCTION_ARGS);
     PG_FUNCTION_INFO_V1(pg_cpp_utils_invoice_hash);
     PG_FUNCTION_INFO_V1(pg_cpp_utils_public_link);
+    PG_FUNCTION_INFO_V1(pg_cpp_utils_invoice_hash_batch);
+    PG_FUNCTION_INFO_V1(pg_cpp_utils_invoice_hash_verify);
+    PG_FUNCTION_INFO_V1(pg_cpp_utils_invoice_hash_verify_batch);
+    PG_FUNCTION_INFO_V1(pg_cpp_utils_sign);
+    PG_FUNCTION_INFO_V1(pg_cpp_utils_sign_verify);
     PG_FUNCTION_INFO_V1(pg_cpp_utils_number_spellout);
+    PG_FUNCTION_INFO_V1(pg_cpp_utils_number_spellout_batch);
     PG_FUNCTION_INFO_V1(pg_cpp_utils_currency_spellout);
+    PG_FUNCTION_INFO_V1(pg_cpp_utils_register_spellout_rules);
+    PG_FUNCTION_INFO_V1(pg_cpp_utils_spellout_rules_invalidate);
     PG_FUNCTION_INFO_V1(pg_cpp_utils_format_number);
     PG_FUNCTION_INFO_V1(pg_cpp_utils_format_message);
+    PG_FUNCTION_INFO_V1(pg_cpp_utils_format_message_typed);
     PG_FUNCTION_INFO_V1(pg_cpp_utils_version);
+    PG_FUNCTION_INFO_V1(pg_cpp_utils_bench);
+    PG_FUNCTION_INFO_V1(pg_cpp_utils_stats);
+    PG_FUNCTION_INFO_V1(pg_cpp_utils_caches);
+    PG_FUNCTION_INFO_V1(pg_cpp_utils_cache_reset);
 } // extern "C"
 
 #if defined(DEBUG)
@@ -75,6 +125,59 @@ extern "C" {
     #define PG_CPP_UTILS_LOG_DEBUG(a_format, ...)
 #endif
 
+/**
+ * @brief Define a function interface to PostreSQL, it's body runs guarded by \link pg::cpp::utils::ErrorBridge::Guard \link:
+ *        errors are raised by throwing, and reach postgres only once the body's C++ state is destroyed.
+ */
+#define PG_CPP_UTILS_FUNCTION(a_name) \
+    static Datum a_name##_guarded (FunctionCallInfo fcinfo); \
+    Datum a_name (PG_FUNCTION_ARGS) \
+    { \
+        return pg::cpp::utils::ErrorBridge::Guard([fcinfo] () -> Datum { \
+            return a_name##_guarded(fcinfo); \
+        }); \
+    } \
+    static Datum a_name##_guarded (FunctionCallInfo fcinfo)
+
+/**
+ * @brief pg_cpp_utils.sign_workers - threads signing a pg_cpp_utils_invoice_hash_batch call, 1 signs in the backend only.
+ */
+static int s_sign_workers_ = 1;
+
+/**
+ * @brief pg_cpp_utils.spellout_memo_size - integral spellouts memoized per backend, 0 disables the memo.
+ */
+static int s_spellout_memo_size_ = 4096;
+
+/**
+ * @brief pg_cpp_utils.cache_size - memory budget, in kB, shared by all backend wide caches.
+ */
+static int s_cache_size_ = 16384;
+
+#ifndef PG_CPP_UTILS_ICU_DATA_FILE
+    #define PG_CPP_UTILS_ICU_DATA_FILE ""
+#endif
+
+/**
+ * @brief True once GUCs and hooks are defined, see _PG_init.
+ */
+static bool s_initialized_ = false;
+
+/**
+ * @brief pg_cpp_utils.icu_data - ICU data package mapped when the module is loaded, see ICU_DATA=trimmed builds.
+ */
+static char* s_icu_data_ = NULL;
+
+/**
+ * @brief pg_cpp_utils_spellout_rules table, InvalidOid until first read by this backend.
+ */
+static Oid s_spellout_rules_relid_ = InvalidOid;
+
+/**
+ * @brief Bumped whenever named spellout rule sets are reset, so call sites stop reusing formatters compiled from old rules.
+ */
+static uint64_t s_spellout_rules_generation_ = 0;
+
 extern "C" {
 
     /*
@@ -83,14 +186,336 @@ extern "C" {
      * - Get backend PID - SELECT pg_backend_pid();
      */
 
+    /**
+     * @brief Named spellout rule sets are loaded again once their table changes, see pg_cpp_utils_spellout_rules_invalidate.
+     *
+     * @param a_arg   Unused.
+     * @param a_relid Changed relation, InvalidOid for all.
+     */
+    static void pg_cpp_utils_spellout_rules_relcache_callback (Datum /* a_arg */, Oid a_relid)
+    {
+        if ( InvalidOid == a_relid || s_spellout_rules_relid_ == a_relid ) {
+            pg::cpp::utils::SpelloutRules::Reset();
+            s_spellout_rules_generation_ += 1;
+        }
+    }
+
+    /**
+     * @brief pg_cpp_utils.spellout_memo_size assign hook, a smaller memo evicts it's least recently used spellouts.
+     *
+     * @param a_value New value.
+     * @param a_extra Unused.
+     */
+    static void pg_cpp_utils_spellout_memo_size_assign (int a_value, void* /* a_extra */)
+    {
+        pg::cpp::utils::SpelloutMemo::Resize(static_cast<size_t>(a_value));
+    }
+
+    /**
+     * @brief pg_cpp_utils.cache_size assign hook, a smaller budget evicts least recently used entries of all caches.
+     *
+     * @param a_value New value, in kB.
+     * @param a_extra Unused.
+     */
+    static void pg_cpp_utils_cache_size_assign (int a_value, void* /* a_extra */)
+    {
+        pg::cpp::utils::Cache::Budget(static_cast<size_t>(a_value) * 1024);
+    }
+
+    /**
+     * @brief Map pg_cpp_utils.icu_data, the message is copied so that no C++ state is alive when it's reported.
+     *
+     * @param a_path
+     * @param o_message Failure message.
+     * @param a_size    \p o_message size.
+     *
+     * @return False on failure.
+     */
+    static bool pg_cpp_utils_icu_data_load (const char* a_path, char* o_message, size_t a_size)
+    {
+        pg::cpp::utils::Status status;
+        if ( true == pg::cpp::utils::ICUData::Load(a_path, status) ) {
+            return true;
+        }
+        strlcpy(o_message, status.Message().c_str(), a_size);
+        return false;
+    }
+
+    /**
+     * @brief Module initialization.
+     */
+    void _PG_init (void)
+    {
+        // ... a load that failed is retried in the same process, with the library still loaded: all that can't be redone is
+        //     done once, and first ...
+        if ( false == s_initialized_ ) {
+            // ... before ICU or OpenSSL allocate anything ...
+            pg::cpp::utils::Allocator::Startup();
+            PG_CPP_UTILS_LOG_DEBUG("ICU memory %s, OpenSSL memory %s",
+                                   pg::cpp::utils::Allocator::IsRouted(pg::cpp::utils::Allocator::Library::ICU)     ? "routed" : "malloc",
+                                   pg::cpp::utils::Allocator::IsRouted(pg::cpp::utils::Allocator::Library::OpenSSL) ? "routed" : "malloc"
+            );
+            DefineCustomStringVariable("pg_cpp_utils.icu_data",
+                                       "ICU data package memory mapped when the module is loaded.",
+                                       "Empty uses the ICU data linked into the module; backends that already loaded it keep their data.",
+                                       &s_icu_data_,
+                                       PG_CPP_UTILS_ICU_DATA_FILE,
+                                       PGC_SIGHUP, 0,
+                                       NULL, NULL, NULL
+            );
+            DefineCustomIntVariable("pg_cpp_utils.sign_workers",
+                                    "Number of threads signing the payloads of a pg_cpp_utils_invoice_hash_batch call.",
+                                    "Includes the backend itself, 1 signs serially.",
+                                    &s_sign_workers_,
+                                    1, 1, 64,
+                                    PGC_USERSET, 0,
+                                    NULL, NULL, NULL
+            );
+            DefineCustomIntVariable("pg_cpp_utils.spellout_memo_size",
+                                    "Number of integral spellouts memoized per backend.",
+                                    "Repeated amounts skip the RBNF engine, 0 disables the memo.",
+                                    &s_spellout_memo_size_,
+                                    4096, 0, 1048576,
+                                    PGC_USERSET, 0,
+                                    NULL, pg_cpp_utils_spellout_memo_size_assign, NULL
+            );
+            DefineCustomIntVariable("pg_cpp_utils.cache_size",
+                                    "Memory budget shared by all of a backend's caches.",
+                                    "Keys, formatters, locales and memoized spellouts; least recently used entries are evicted first.",
+                                    &s_cache_size_,
+                                    16384, 64, MAX_KILOBYTES,
+                                    PGC_USERSET, GUC_UNIT_KB,
+                                    NULL, pg_cpp_utils_cache_size_assign, NULL
+            );
+#if PG_VERSION_NUM >= 150000
+            MarkGUCPrefixReserved("pg_cpp_utils");
+#else
+            EmitWarningsOnPlaceholders("pg_cpp_utils");
+#endif
+            CacheRegisterRelcacheCallback(pg_cpp_utils_spellout_rules_relcache_callback, (Datum) 0);
+            pg::cpp::utils::Stats::Startup();
+            s_initialized_ = true;
+        }
+        // ... last, but still before ICU loads any data ...
+        if ( NULL != s_icu_data_ && '\0' != s_icu_data_[0] && false == pg::cpp::utils::ICUData::IsLoaded() ) {
+            char message[512];
+            if ( false == pg_cpp_utils_icu_data_load(s_icu_data_, message, sizeof(message)) ) {
+                // ... a trimmed build links no ICU data at all ...
+                ereport('\0' != PG_CPP_UTILS_ICU_DATA_FILE[0] ? ERROR : WARNING,
+                        (errcode(ERRCODE_CONFIG_FILE_ERROR), errmsg("%s", message)));
+            } else {
+                PG_CPP_UTILS_LOG_DEBUG("ICU data %s, %zu bytes mapped", s_icu_data_, pg::cpp::utils::ICUData::Size());
+            }
+        }
+    }
+
+} // extern "C"
+
+/*
+ * Dispatch layer: templates over the utility type, so calling into an utility needs neither type erasure nor a virtual call.
+ */
+
+    /**
+     * @brief Call site state, kept at flinfo->fn_extra ( allocated from fn_mcxt ) so that repeated calls from the same plan
+     *        node skip the result type lookup and, while their binding ( locale, pattern, ... ) is unchanged, utility setup.
+     */
+    typedef struct {
+        MemoryContextCallback    callback_;
+        FmgrInfo*                flinfo_;
+        FuncCallContext*         srf_;       // SRF protocol state, at fn_extra only while the protocol macros run
+        ExprContext*             econtext_;  // where the SRF state's shutdown callbacks are registered, nullptr if none
+        AttInMetadata*           attinmeta_; // result type, built on first call
+        pg::cpp::utils::Utility* utility_;   // utility of the last successful call, reused by calls with the same binding
+        std::string*             binding_;
+    } PgCppUtilsCallSite;
+
+    /**
+     * @brief Memory context reset callback, releases a call site's utility along with fn_mcxt.
+     *
+     * @param a_arg \link PgCppUtilsCallSite \link
+     */
+    static void pg_cpp_utils_call_site_release (void* a_arg)
+    {
+        PgCppUtilsCallSite* site = static_cast<PgCppUtilsCallSite*>(a_arg);
+        delete site->utility_;
+        delete site->binding_;
+        site->utility_ = nullptr;
+        site->binding_ = nullptr;
+    }
+
+    /**
+     * @brief ExprContext shutdown callback, registered after shutdown_MultiFuncCall so it runs first: puts the SRF state
+     *        it expects back at fn_extra, for a SRF stopped before SRF_RETURN_DONE ( LIMIT, rescan, non SETOF call ).
+     *
+     * @param a_arg \link PgCppUtilsCallSite \link
+     */
+    static void pg_cpp_utils_call_site_srf_shutdown (Datum a_arg)
+    {
+        PgCppUtilsCallSite* site = (PgCppUtilsCallSite*) DatumGetPointer(a_arg);
+        site->flinfo_->fn_extra = site->srf_;
+        site->srf_              = nullptr;
+    }
+
+    /**
+     * @brief ExprContext shutdown callback, registered before shutdown_MultiFuncCall so it runs last: once the SRF state
+     *        is released, fn_extra is the call site's again.
+     *
+     * @param a_arg \link PgCppUtilsCallSite \link
+     */
+    static void pg_cpp_utils_call_site_srf_restore (Datum a_arg)
+    {
+        PgCppUtilsCallSite* site = (PgCppUtilsCallSite*) DatumGetPointer(a_arg);
+        site->flinfo_->fn_extra = site;
+        site->srf_              = nullptr;
+        site->econtext_         = nullptr;
+    }
+
+    /**
+     * @brief Run a SRF protocol implementation with it's call site state, the protocol's own state is swapped in and out
+     *        of fn_extra around it.
+     *
+     * @param fcinfo
+     * @param a_srf_func Datum ( PgCppUtilsCallSite* ).
+     *
+     * @remarks SRF_FIRSTCALL_INIT registers shutdown_MultiFuncCall, which takes fn_extra for it's state: the call site's
+     *          own callbacks, run LIFO, surround it so it finds that state and leaves the call site in place.
+     */
+    template <typename SrfFunc>
+    static Datum pg_cpp_utils_call_site (FunctionCallInfo fcinfo, SrfFunc&& a_srf_func)
+    {
+        PgCppUtilsCallSite* site = static_cast<PgCppUtilsCallSite*>(fcinfo->flinfo->fn_extra);
+        if ( nullptr == site ) {
+            site = (PgCppUtilsCallSite*)MemoryContextAllocZero(fcinfo->flinfo->fn_mcxt, sizeof(PgCppUtilsCallSite));
+            site->flinfo_        = fcinfo->flinfo;
+            site->callback_.func = pg_cpp_utils_call_site_release;
+            site->callback_.arg  = site;
+            MemoryContextRegisterResetCallback(fcinfo->flinfo->fn_mcxt, &site->callback_);
+        }
+
+        Datum result = (Datum) 0;
+
+        fcinfo->flinfo->fn_extra = site->srf_;
+        try {
+            // ... protocol postgres errors, e.g. from BuildTupleFromCStrings, must unwind the caller's C++ state too ...
+            pg::cpp::utils::ErrorBridge::Call([&result, &a_srf_func, site, fcinfo] () {
+                ReturnSetInfo* rsinfo = ( nullptr != fcinfo->resultinfo && IsA(fcinfo->resultinfo, ReturnSetInfo) ) ? (ReturnSetInfo*) fcinfo->resultinfo : nullptr;
+                const bool     first  = ( nullptr == site->srf_ && nullptr != rsinfo );
+                if ( true == first ) {
+                    RegisterExprContextCallback(rsinfo->econtext, pg_cpp_utils_call_site_srf_restore, PointerGetDatum(site));
+                    site->econtext_ = rsinfo->econtext;
+                }
+                result = a_srf_func(site);
+                if ( nullptr != site->econtext_ ) {
+                    if ( nullptr == fcinfo->flinfo->fn_extra ) {
+                        // ... SRF_RETURN_DONE, or nothing started: shutdown_MultiFuncCall is no longer registered ...
+                        UnregisterExprContextCallback(site->econtext_, pg_cpp_utils_call_site_srf_shutdown, PointerGetDatum(site));
+                        UnregisterExprContextCallback(site->econtext_, pg_cpp_utils_call_site_srf_restore, PointerGetDatum(site));
+                        site->econtext_ = nullptr;
+                    } else if ( true == first ) {
+                        RegisterExprContextCallback(site->econtext_, pg_cpp_utils_call_site_srf_shutdown, PointerGetDatum(site));
+                    }
+                }
+            });
+        } catch (...) {
+            // ... an abandoned protocol state must not be taken for this call site's, the query is aborted so no
+            //     ExprContext callback runs ...
+            site->srf_               = nullptr;
+            site->econtext_          = nullptr;
+            fcinfo->flinfo->fn_extra = site;
+            throw;
+        }
+        site->srf_               = static_cast<FuncCallContext*>(fcinfo->flinfo->fn_extra);
+        fcinfo->flinfo->fn_extra = site;
+
+        return result;
+    }
+
+    /**
+     * @brief Build a call site's result type, once: allocated from fn_mcxt, it outlives the SRF state and so later scans
+     *        of the same plan node.
+     *
+     * @param fcinfo
+     * @param a_site
+     * @param a_context Memory context to restore on error.
+     */
+    static void pg_cpp_utils_call_site_attinmeta (FunctionCallInfo fcinfo, PgCppUtilsCallSite* a_site, MemoryContext a_context)
+    {
+        if ( nullptr != a_site->attinmeta_ ) {
+            return;
+        }
+
+        MemoryContext       srf_context = MemoryContextSwitchTo(fcinfo->flinfo->fn_mcxt);
+        TupleDesc           tupdesc;
+        const TypeFuncClass return_type = get_call_result_type(fcinfo, NULL, &tupdesc);
+        if ( TYPEFUNC_COMPOSITE != return_type ) {
+            // ... restore context ...
+            MemoryContextSwitchTo(a_context);
+            // ... report error ....
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "Expecting result type %d ( TYPEFUNC_COMPOSITE ) not %d!", TYPEFUNC_COMPOSITE, return_type);
+        }
+        a_site->attinmeta_ = TupleDescGetAttInMetadata(tupdesc);
+        MemoryContextSwitchTo(srf_context);
+    }
+
+    /**
+     * @brief Build a call site binding, the arguments a utility was set up with.
+     *
+     * @param a_parts
+     */
+    static std::string pg_cpp_utils_binding (std::initializer_list<pg::cpp::utils::StringView> a_parts)
+    {
+        std::string binding;
+        for ( auto& part : a_parts ) {
+            binding.append(part.Data(), part.Length());
+            binding.push_back('\0');
+        }
+        return binding;
+    }
+
+    /**
+     * @brief Release an utility, constructed either at \p a_frame_memory or on the heap.
+     *
+     * @param a_utility
+     * @param a_frame_memory
+     */
+    template <typename U>
+    static inline void pg_cpp_utils_utility_release (U* a_utility, const void* a_frame_memory)
+    {
+        if ( static_cast<const void*>(a_utility) == a_frame_memory ) {
+            a_utility->~U();
+        } else {
+            delete a_utility;
+        }
+    }
+
+    /**
+     * @brief Construct an utility on the heap, for those outliving the call.
+     *
+     * @param a_alloc_utility_func U* ( void* memory ), constructs the utility at memory with placement new.
+     */
+    template <typename U, typename AllocFunc>
+    static inline U* pg_cpp_utils_utility_new (AllocFunc& a_alloc_utility_func)
+    {
+        void* memory = ::operator new(sizeof(U));
+        try {
+            return a_alloc_utility_func(memory);
+        } catch (...) {
+            ::operator delete(memory);
+            throw;
+        }
+    }
+
     /**
      * @brief SEE interface to PostreSQL
      */
-    Datum pg_cpp_utils_utils_common (FunctionCallInfo fcinfo,
-                                     const std::function<pg::cpp::utils::Utility*()> a_alloc_utility_func,
-                                     const std::function<void(pg::cpp::utils::Utility*)> a_perform_func,
-                                     const std::function<pg::cpp::utils::Utility*(pg::cpp::utils::Utility*)> a_dealloc_utility_func
-                                     )
+    template <typename U, typename AllocFunc, typename PerformFunc>
+    static Datum pg_cpp_utils_utils_common_srf (FunctionCallInfo fcinfo,
+                                                PgCppUtilsCallSite* a_site,
+                                                const pg::cpp::utils::Stats::Function a_function,
+                                                AllocFunc& a_alloc_utility_func,
+                                                PerformFunc& a_perform_func,
+                                                const std::string& a_binding
+                                                )
     {
 
         FuncCallContext* func_call_context;
@@ -100,616 +525,1563 @@ extern "C" {
             // ... create a function context for cross-call persistence ...
             func_call_context = SRF_FIRSTCALL_INIT();
 
-            // ... switch to memory context appropriate for multiple function calls ...
-            MemoryContext old_context = MemoryContextSwitchTo(func_call_context->multi_call_memory_ctx);
+            // ... switch to memory context appropriate for multiple function calls ...
+            MemoryContext old_context = MemoryContextSwitchTo(func_call_context->multi_call_memory_ctx);
+
+            // ... build a tuple descriptor for our result type, once per call site ...
+            pg_cpp_utils_call_site_attinmeta(fcinfo, a_site, old_context);
+            func_call_context->attinmeta = a_site->attinmeta_;
+
+            // ... account call ...
+            pg::cpp::utils::Stats::Begin(a_function);
+            const auto start      = std::chrono::steady_clock::now();
+            const auto elapsed_us = [&start] () -> uint64_t {
+                return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+            };
+
+            // ... create utility - on this frame, unless kept by the call site - or reuse the call site's one when set up with the same arguments ...
+            typename std::aligned_storage<sizeof(U), alignof(U)>::type frame_memory;
+            U*   utility = static_cast<U*>(a_site->utility_);
+            bool failed  = false;
+            a_site->utility_ = nullptr;
+            try {
+                if ( nullptr == utility || true == a_binding.empty() || a_binding != *a_site->binding_ ) {
+                    delete utility;
+                    utility = nullptr;
+                    utility = ( true == a_binding.empty() ? a_alloc_utility_func(&frame_memory) : pg_cpp_utils_utility_new<U>(a_alloc_utility_func) );
+                }
+                // ... perform, unless it could not be set up - postgres errors, e.g. out of memory, must not skip this frame ...
+                pg::cpp::utils::ErrorBridge::Call([&] () {
+                    if ( false == utility->LastStatus().Failed() ) {
+                        a_perform_func(*utility);
+                    }
+                    failed = utility->LastStatus().Failed();
+                    if ( false == failed ) {
+                        // ... allocate user func context ...
+                        pg::cpp::utils::Utility::AllocUserFuncContext(func_call_context);
+                        // ... set result data to function call context ...
+                        utility->FillOutputAtUserFuncContext(func_call_context);
+                    }
+                });
+            } catch (...) {
+                // ... release utility ...
+                pg_cpp_utils_utility_release(utility, &frame_memory);
+                // ... dealloc user func context ...
+                pg::cpp::utils::Utility::DeallocUserFuncContext(func_call_context);
+                // ... account failure ...
+                pg::cpp::utils::Stats::End(a_function, elapsed_us(), /* a_failed */ true);
+                // ... reported by the function's guard, see PG_CPP_UTILS_FUNCTION ...
+                throw;
+            }
+
+            // ... utility errors are statuses, not exceptions ...
+            if ( true == failed ) {
+                const pg::cpp::utils::ErrorBridge::Error error(ERRCODE_FEATURE_NOT_SUPPORTED, "%s", utility->LastStatus().Message().c_str());
+                // ... release utility ...
+                pg_cpp_utils_utility_release(utility, &frame_memory);
+                // ... account failure ...
+                pg::cpp::utils::Stats::End(a_function, elapsed_us(), /* a_failed */ true);
+                // ... report error ...
+                throw error;
+            }
+
+            // ... keep it for the next call with the same binding ...
+            if ( false == a_binding.empty() ) {
+                if ( nullptr == a_site->binding_ ) {
+                    a_site->binding_ = new std::string();
+                }
+                a_site->binding_->assign(a_binding);
+                a_site->utility_ = utility;
+            } else {
+                pg_cpp_utils_utility_release(utility, &frame_memory);
+            }
+
+            // ... account success ...
+            pg::cpp::utils::Stats::End(a_function, elapsed_us(), /* a_failed */ false);
+
+            // ... restore context ...
+            MemoryContextSwitchTo(old_context);
+        }
+
+        // ... stuff done on every call of the function ...
+        func_call_context = SRF_PERCALL_SETUP();
+
+#ifdef __APPLE__
+    #define CALL_CNTR_FMT PRIu32
+#else
+    #define CALL_CNTR_FMT PRIu64
+#endif
+
+        // ... if still data rows to return ....
+        if ( func_call_context->call_cntr < func_call_context->max_calls ) {
+
+            // ... access user function call data ...
+            pg::cpp::utils::Utility::Records* records = pg::cpp::utils::Utility::UserFuncContextRecords(func_call_context);
+
+            // ... pick current row values ( owned by multi_call_memory_ctx ) ...
+            char** values = records->Values(func_call_context->call_cntr);
+            // ... no data?
+            if ( nullptr == values ) {
+                // ... for debug proposes only ...
+                PG_CPP_UTILS_LOG_DEBUG("----- CALL #%" CALL_CNTR_FMT " ----- NO DATA", func_call_context->call_cntr);
+                // ... next ...
+                SRF_RETURN_NEXT_NULL(func_call_context);
+            }
+
+            // ... for debug proposes only ...
+            PG_CPP_UTILS_LOG_DEBUG("----- CALL #%" CALL_CNTR_FMT " ----- [%zd]: %s", func_call_context->call_cntr, strlen(values[0]), values[0]);
+
+            //... build a tuple ....
+            HeapTuple tuple = BuildTupleFromCStrings(func_call_context->attinmeta, values);
+
+            //... make the tuple into a datum ...
+            Datum result = HeapTupleGetDatum(tuple);
+
+            // ... next ...
+            SRF_RETURN_NEXT(func_call_context, result);
+        } else {
+            // ... dealloc user func context ...
+            pg::cpp::utils::Utility::DeallocUserFuncContext(func_call_context);
+            // ... for debug proposes only ...
+            PG_CPP_UTILS_LOG_DEBUG("----- %s -----", "FINAL_CALL");
+            // ... we're done ...
+            SRF_RETURN_DONE(func_call_context);
+        }
+
+    }
+
+    /**
+     * @brief SEE interface to PostreSQL
+     *
+     * @param a_alloc_utility_func U* ( void* memory ), constructs the utility at memory with placement new.
+     * @param a_perform_func       void ( U& ).
+     * @param a_binding            Arguments the utility is set up with, a call site reuses it's utility while they don't
+     *                             change; empty to set up an utility per call.
+     */
+    template <typename U, typename AllocFunc, typename PerformFunc>
+    static Datum pg_cpp_utils_utils_common (FunctionCallInfo fcinfo,
+                                            const pg::cpp::utils::Stats::Function a_function,
+                                            AllocFunc&& a_alloc_utility_func,
+                                            PerformFunc&& a_perform_func,
+                                            const std::string& a_binding = std::string()
+                                            )
+    {
+        return pg_cpp_utils_call_site(fcinfo, [fcinfo, a_function, &a_alloc_utility_func, &a_perform_func, &a_binding] (PgCppUtilsCallSite* a_site) -> Datum {
+            return pg_cpp_utils_utils_common_srf<U>(fcinfo, a_site, a_function, a_alloc_utility_func, a_perform_func, a_binding);
+        });
+    }
+
+    /**
+     * @brief Streamed result state, released along with the memory context it was allocated from.
+     */
+    typedef struct {
+        MemoryContextCallback           callback_;
+        pg::cpp::utils::Utility*        utility_;
+        pg::cpp::utils::Stats::Function function_;
+        uint64_t                        elapsed_us_;
+    } PgCppUtilsStreamState;
+
+    /**
+     * @brief Memory context reset callback, releases an utility abandoned before it's last record ( LIMIT, cursor closed or error ).
+     *
+     * @param a_arg \link PgCppUtilsStreamState \link
+     */
+    static void pg_cpp_utils_stream_release (void* a_arg)
+    {
+        PgCppUtilsStreamState* state = static_cast<PgCppUtilsStreamState*>(a_arg);
+        if ( nullptr != state->utility_ ) {
+            delete state->utility_;
+            state->utility_ = nullptr;
+            // ... account call ...
+            pg::cpp::utils::Stats::End(state->function_, state->elapsed_us_, /* a_failed */ false);
+        }
+    }
+
+    /**
+     * @brief Register a streamed result state at a memory context.
+     *
+     * @param a_context
+     * @param a_function
+     */
+    static PgCppUtilsStreamState* pg_cpp_utils_stream_state (MemoryContext a_context, const pg::cpp::utils::Stats::Function a_function)
+    {
+        PgCppUtilsStreamState* state = (PgCppUtilsStreamState*)MemoryContextAllocZero(a_context, sizeof(PgCppUtilsStreamState));
+        state->function_      = a_function;
+        state->callback_.func = pg_cpp_utils_stream_release;
+        state->callback_.arg  = state;
+        MemoryContextRegisterResetCallback(a_context, &state->callback_);
+        return state;
+    }
+
+    /**
+     * @brief Perform a streamed result step, translating C++ exceptions and utility statuses to postgres errors.
+     *
+     * @param a_state
+     * @param a_step void ().
+     */
+    template <typename StepFunc>
+    static void pg_cpp_utils_stream_step (PgCppUtilsStreamState* a_state, StepFunc&& a_step)
+    {
+        pg::cpp::utils::Stats::Begin(a_state->function_);
+        const auto start      = std::chrono::steady_clock::now();
+        const auto elapsed_us = [&start] () -> uint64_t {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+        };
+        const auto fail = [a_state, &elapsed_us] () {
+            // ... release utility ...
+            delete a_state->utility_;
+            a_state->utility_ = nullptr;
+            // ... account failure ...
+            pg::cpp::utils::Stats::End(a_state->function_, a_state->elapsed_us_ + elapsed_us(), /* a_failed */ true);
+        };
+
+        bool failed = false;
+        try {
+            pg::cpp::utils::ErrorBridge::Call(a_step);
+            failed = ( nullptr != a_state->utility_ && true == a_state->utility_->LastStatus().Failed() );
+        } catch (...) {
+            fail();
+            // ... reported by the function's guard, see PG_CPP_UTILS_FUNCTION ...
+            throw;
+        }
+
+        // ... utility errors are statuses, not exceptions ...
+        if ( true == failed ) {
+            const pg::cpp::utils::ErrorBridge::Error error(ERRCODE_FEATURE_NOT_SUPPORTED, "%s", a_state->utility_->LastStatus().Message().c_str());
+            fail();
+            // ... report error ...
+            throw error;
+        }
+
+        a_state->elapsed_us_ += elapsed_us();
+    }
+
+    /**
+     * @brief Value-per-call interface to PostreSQL: one \link pg::cpp::utils::Utility::Next \link call per row,
+     *        so only the row being returned is kept in memory.
+     */
+    template <typename U, typename AllocFunc, typename PerformFunc>
+    static Datum pg_cpp_utils_utils_value_per_call_srf (FunctionCallInfo fcinfo,
+                                                        PgCppUtilsCallSite* a_site,
+                                                        const pg::cpp::utils::Stats::Function a_function,
+                                                        AllocFunc& a_alloc_utility_func,
+                                                        PerformFunc& a_perform_func
+                                                        )
+    {
+        FuncCallContext*       func_call_context;
+        PgCppUtilsStreamState* state;
+
+        if ( SRF_IS_FIRSTCALL() ) {
+
+            // ... create a function context for cross-call persistence ...
+            func_call_context = SRF_FIRSTCALL_INIT();
+
+            // ... switch to memory context appropriate for multiple function calls ...
+            MemoryContext old_context = MemoryContextSwitchTo(func_call_context->multi_call_memory_ctx);
+
+            // ... build a tuple descriptor for our result type, once per call site ...
+            pg_cpp_utils_call_site_attinmeta(fcinfo, a_site, old_context);
+            func_call_context->attinmeta = a_site->attinmeta_;
+
+            // ... utility lives until the last row, or until multi_call_memory_ctx is deleted ...
+            state = pg_cpp_utils_stream_state(func_call_context->multi_call_memory_ctx, a_function);
+            func_call_context->user_fctx = state;
+
+            // ... create utility and perform ...
+            pg_cpp_utils_stream_step(state,
+                                     [state, &a_alloc_utility_func, &a_perform_func] () {
+                                         U* utility = pg_cpp_utils_utility_new<U>(a_alloc_utility_func);
+                                         state->utility_ = utility;
+                                         if ( false == utility->LastStatus().Failed() ) {
+                                             a_perform_func(*utility);
+                                         }
+                                     }
+            );
+
+            // ... restore context ...
+            MemoryContextSwitchTo(old_context);
+        }
+
+        // ... stuff done on every call of the function ...
+        func_call_context = SRF_PERCALL_SETUP();
+        state             = static_cast<PgCppUtilsStreamState*>(func_call_context->user_fctx);
+
+        // ... next row, allocated from the per call memory context ...
+        pg::cpp::utils::Utility::Records records(CurrentMemoryContext);
+        bool                             next = false;
+        pg_cpp_utils_stream_step(state,
+                                 [state, &records, &next] () {
+                                     next = static_cast<U*>(state->utility_)->Next(records);
+                                 }
+        );
+
+        if ( true == next && records.Count() > 0 ) {
+            //... build a tuple ....
+            HeapTuple tuple = BuildTupleFromCStrings(func_call_context->attinmeta, records.Values(0));
+            // ... next ...
+            SRF_RETURN_NEXT(func_call_context, HeapTupleGetDatum(tuple));
+        }
+
+        // ... release utility ...
+        delete static_cast<U*>(state->utility_);
+        state->utility_ = nullptr;
+
+        // ... account success ...
+        pg::cpp::utils::Stats::End(a_function, state->elapsed_us_, /* a_failed */ false);
+
+        // ... we're done ...
+        SRF_RETURN_DONE(func_call_context);
+    }
+
+    /**
+     * @brief Value-per-call interface to PostreSQL, see \link pg_cpp_utils_utils_value_per_call_srf \link.
+     */
+    template <typename U, typename AllocFunc, typename PerformFunc>
+    static Datum pg_cpp_utils_utils_value_per_call (FunctionCallInfo fcinfo,
+                                                    const pg::cpp::utils::Stats::Function a_function,
+                                                    AllocFunc&& a_alloc_utility_func,
+                                                    PerformFunc&& a_perform_func
+                                                    )
+    {
+        return pg_cpp_utils_call_site(fcinfo, [fcinfo, a_function, &a_alloc_utility_func, &a_perform_func] (PgCppUtilsCallSite* a_site) -> Datum {
+            return pg_cpp_utils_utils_value_per_call_srf<U>(fcinfo, a_site, a_function, a_alloc_utility_func, a_perform_func);
+        });
+    }
+
+    /**
+     * @brief Materialize interface to PostreSQL: rows are produced one at a time by \link pg::cpp::utils::Utility::Next \link
+     *        and copied to a tuple store, which spills to disk past work_mem.
+     */
+    template <typename U, typename AllocFunc, typename PerformFunc>
+    static Datum pg_cpp_utils_utils_materialize_srf (FunctionCallInfo fcinfo,
+                                                     const pg::cpp::utils::Stats::Function a_function,
+                                                     AllocFunc& a_alloc_utility_func,
+                                                     PerformFunc& a_perform_func
+                                                     )
+    {
+        ReturnSetInfo* rsinfo = (ReturnSetInfo*)fcinfo->resultinfo;
+        if ( nullptr == rsinfo || false == IsA(rsinfo, ReturnSetInfo) || 0 == ( rsinfo->allowedModes & SFRM_Materialize ) ) {
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "Materialize mode required, but it is not allowed in this context!");
+        }
+
+        // ... tuple store and descriptor must outlive this call ...
+        MemoryContext old_context = MemoryContextSwitchTo(rsinfo->econtext->ecxt_per_query_memory);
+
+        // ... build a tuple descriptor for our result type ...
+        TupleDesc tupdesc;
+        const TypeFuncClass return_type = get_call_result_type(fcinfo, NULL, &tupdesc);
+        if ( TYPEFUNC_COMPOSITE != return_type ) {
+            // ... restore context ...
+            MemoryContextSwitchTo(old_context);
+            // ... report error ....
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "Expecting result type %d ( TYPEFUNC_COMPOSITE ) not %d!", TYPEFUNC_COMPOSITE, return_type);
+        }
+
+        Tuplestorestate* tuple_store = tuplestore_begin_heap(0 != ( rsinfo->allowedModes & SFRM_Materialize_Random ), false, work_mem);
+        AttInMetadata*   attinmeta   = TupleDescGetAttInMetadata(tupdesc);
+
+        rsinfo->returnMode = SFRM_Materialize;
+        rsinfo->setResult  = tuple_store;
+        rsinfo->setDesc    = tupdesc;
+
+        // ... restore context ...
+        MemoryContextSwitchTo(old_context);
+
+        // ... utility is released along with this context, if an error escapes ...
+        MemoryContext stream_context = AllocSetContextCreate(CurrentMemoryContext, "pg_cpp_utils stream", ALLOCSET_SMALL_SIZES);
+        MemoryContext row_context    = AllocSetContextCreate(stream_context, "pg_cpp_utils row", ALLOCSET_DEFAULT_SIZES);
+
+        PgCppUtilsStreamState* state = pg_cpp_utils_stream_state(stream_context, a_function);
+
+        // ... create utility and perform ...
+        pg_cpp_utils_stream_step(state,
+                                 [state, &a_alloc_utility_func, &a_perform_func] () {
+                                     U* utility = pg_cpp_utils_utility_new<U>(a_alloc_utility_func);
+                                     state->utility_ = utility;
+                                     if ( false == utility->LastStatus().Failed() ) {
+                                         a_perform_func(*utility);
+                                     }
+                                 }
+        );
+
+        // ... one row at a time, row memory is reset once copied to the tuple store ...
+        while ( true ) {
+            pg::cpp::utils::Utility::Records records(row_context);
+            bool                             next = false;
+            pg_cpp_utils_stream_step(state,
+                                     [state, &records, &next] () {
+                                         next = static_cast<U*>(state->utility_)->Next(records);
+                                     }
+            );
+            if ( false == next ) {
+                break;
+            }
+            old_context = MemoryContextSwitchTo(row_context);
+            for ( size_t idx = 0 ; idx < records.Count() ; ++idx ) {
+                tuplestore_puttuple(tuple_store, BuildTupleFromCStrings(attinmeta, records.Values(idx)));
+            }
+            MemoryContextSwitchTo(old_context);
+            MemoryContextReset(row_context);
+        }
+
+        // ... release utility ...
+        delete static_cast<U*>(state->utility_);
+        state->utility_ = nullptr;
+
+        // ... account success ...
+        pg::cpp::utils::Stats::End(a_function, state->elapsed_us_, /* a_failed */ false);
+
+        MemoryContextDelete(stream_context);
+
+        return (Datum) 0;
+    }
+
+    /**
+     * @brief Materialize interface to PostreSQL, see \link pg_cpp_utils_utils_materialize_srf \link.
+     */
+    template <typename U, typename AllocFunc, typename PerformFunc>
+    static Datum pg_cpp_utils_utils_materialize (FunctionCallInfo fcinfo,
+                                                 const pg::cpp::utils::Stats::Function a_function,
+                                                 AllocFunc&& a_alloc_utility_func,
+                                                 PerformFunc&& a_perform_func
+                                                 )
+    {
+        Datum result = (Datum) 0;
+        // ... tuple store postgres errors, e.g. when spilling to disk, must unwind the caller's C++ state too ...
+        pg::cpp::utils::ErrorBridge::Call([&] () {
+            result = pg_cpp_utils_utils_materialize_srf<U>(fcinfo, a_function, a_alloc_utility_func, a_perform_func);
+        });
+        return result;
+    }
+
+extern "C" {
+
+    /**
+     * @brief View of a text ( or bytea ) argument, obtained with PG_GETARG_TEXT_PP: short varlenas are not copied, only
+     *        compressed or out of line values are detoasted ( into the call's memory context ).
+     *
+     * @param a_text
+     *
+     * @return View valid until the end of the call.
+     */
+    static inline pg::cpp::utils::StringView pg_cpp_utils_text_view (const text* a_text)
+    {
+        return pg::cpp::utils::StringView(VARDATA_ANY(a_text), VARSIZE_ANY_EXHDR(a_text));
+    }
+
+    /**
+     * @brief Where an invoice hash key argument comes from: a PEM file path ( text ), PEM text or PEM / DER bytea.
+     *
+     * @param fcinfo
+     * @param a_arg
+     * @param a_key
+     */
+    static pg::cpp::utils::KeyCache::Source pg_cpp_utils_key_source (FunctionCallInfo fcinfo, const int a_arg, const pg::cpp::utils::StringView& a_key)
+    {
+        if ( BYTEAOID == get_fn_expr_argtype(fcinfo->flinfo, a_arg) || true == a_key.StartsWith("-----BEGIN") ) {
+            return pg::cpp::utils::KeyCache::Source::Memory;
+        }
+        return pg::cpp::utils::KeyCache::Source::File;
+    }
+
+    /**
+     * @brief Qualified name of the pg_cpp_utils_spellout_rules table, created in the same schema as the calling function.
+     *
+     * @param fcinfo
+     */
+    static const char* pg_cpp_utils_spellout_rules_table (FunctionCallInfo fcinfo)
+    {
+        const Oid namespace_oid = get_func_namespace(fcinfo->flinfo->fn_oid);
+        const Oid relid         = get_relname_relid("pg_cpp_utils_spellout_rules", namespace_oid);
+        if ( InvalidOid == relid ) {
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_UNDEFINED_TABLE, "pg_cpp_utils_spellout_rules table not found!");
+        }
+        s_spellout_rules_relid_ = relid;
+        return quote_qualified_identifier(get_namespace_name(namespace_oid), "pg_cpp_utils_spellout_rules");
+    }
+
+    /**
+     * @brief Load a named spellout rule set, for all it's locales, if the override is a name not yet loaded by this backend.
+     *
+     * @param fcinfo
+     * @param a_spellout_override
+     */
+    static void pg_cpp_utils_spellout_rules_load (FunctionCallInfo fcinfo, const pg::cpp::utils::StringView& a_spellout_override)
+    {
+        if ( false == pg::cpp::utils::SpelloutRules::IsName(a_spellout_override) || true == pg::cpp::utils::SpelloutRules::IsLoaded(a_spellout_override) ) {
+            return;
+        }
+
+        const char* table = pg_cpp_utils_spellout_rules_table(fcinfo);
+
+        StringInfoData query;
+        initStringInfo(&query);
+        appendStringInfo(&query, "SELECT locale, rules FROM %s WHERE name = $1", table);
+
+        Oid   arg_types[1] = { TEXTOID };
+        Datum arg_values[1] = { PointerGetDatum(cstring_to_text_with_len(a_spellout_override.Data(), static_cast<int>(a_spellout_override.Length()))) };
+
+        SPI_connect();
+
+        // ... SPI errors are raised while definitions are alive, they must travel as C++ exceptions ...
+        std::vector<pg::cpp::utils::SpelloutRules::Definition> definitions;
+        try {
+            int rv = SPI_OK_SELECT;
+            pg::cpp::utils::ErrorBridge::Call([&rv, &query, &arg_types, &arg_values] () {
+                rv = SPI_execute_with_args(query.data, 1, arg_types, arg_values, /* a_nulls */ NULL, /* a_read_only */ true, 0);
+            });
+            if ( SPI_OK_SELECT != rv ) {
+                throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_INTERNAL_ERROR, "pg_cpp_utils_spellout_rules - unable to read rule set '%.*s', SPI error %d!",
+                                                         static_cast<int>(a_spellout_override.Length()), a_spellout_override.Data(), rv);
+            }
+            definitions.reserve(static_cast<size_t>(SPI_processed));
+            for ( uint64 idx = 0 ; idx < SPI_processed ; ++idx ) {
+                HeapTuple   tuple  = SPI_tuptable->vals[idx];
+                const char* locale = nullptr;
+                const char* rules  = nullptr;
+                pg::cpp::utils::ErrorBridge::Call([tuple, &locale, &rules] () {
+                    locale = SPI_getvalue(tuple, SPI_tuptable->tupdesc, 1);
+                    rules  = SPI_getvalue(tuple, SPI_tuptable->tupdesc, 2);
+                });
+                definitions.push_back(pg::cpp::utils::SpelloutRules::Definition(locale, rules));
+            }
+            // ... definitions are copied, SPI memory is released by SPI_finish ...
+            pg::cpp::utils::SpelloutRules::Load(a_spellout_override, definitions);
+        } catch (...) {
+            SPI_finish();
+            throw;
+        }
+
+        SPI_finish();
+    }
+
+    /**
+     * @brief pg-cpp-utils invoice hash interface to PostreSQL
+     *
+     * http://info.portaldasfinancas.gov.pt/NR/rdonlyres/89DB70CE-7BB5-417B-B13E-C72A912FF66E/0/Despacho_n_8632_2014_03_07.pdf
+     */
+    PG_CPP_UTILS_FUNCTION(pg_cpp_utils_invoice_hash)
+    {
+        // ... test the number of arguments ...
+        const size_t args_count = PG_NARGS();
+        if ( 2 != args_count ) {
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_invoice_hash(...) - received %zd argument(s), expected at least %d argument(s)!", args_count, 2);
+        }
+
+        // ... collect param(s) ...
+        text* tmp_pem_uri         = PG_GETARG_TEXT_PP(0);
+        text* tmp_payload         = PG_GETARG_TEXT_PP(1);
+
+        if ( nullptr == tmp_pem_uri ) {
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_invoice_hash(...) - pem uri argument can not be null!");
+        }
+
+        if ( nullptr == tmp_payload ) {
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_invoice_hash(...) - payload argument can not be null!");
+        }
+
+        const pg::cpp::utils::StringView pem_uri = pg_cpp_utils_text_view(tmp_pem_uri);
+
+        const pg::cpp::utils::KeyCache::Source key_source = pg_cpp_utils_key_source(fcinfo, 0, pem_uri);
+        const pg::cpp::utils::StringView payload = pg_cpp_utils_text_view(tmp_payload);
+
+        // ... perform request ...
+        return pg_cpp_utils_utils_common<pg::cpp::utils::InvoiceHash>(fcinfo,
+                                                             pg::cpp::utils::Stats::Function::InvoiceHash,
+                                                             /* allocation */
+                                                             [&pem_uri, &key_source] (void* a_memory) -> pg::cpp::utils::InvoiceHash* {
+                                                                 return new (a_memory) pg::cpp::utils::InvoiceHash(pem_uri, key_source);
+                                                             },
+                                                             /* execute */
+                                                             [&payload] (pg::cpp::utils::InvoiceHash& a_utility) -> void {
+                                                                 // ... perform ...
+                                                                 a_utility.Calculate(payload);
+                                                             }
+        );
+    }
+
+    /**
+     * @brief Collect a text[] argument.
+     *
+     * @param fcinfo
+     * @param a_arg
+     * @param o_values Views of the array elements, valid until the end of the call.
+     * @param o_nulls  Set to true for null elements, values that were already null are kept.
+     */
+    static void pg_cpp_utils_text_array (FunctionCallInfo fcinfo, const int a_arg, std::vector<pg::cpp::utils::StringView>& o_values, std::vector<bool>& o_nulls)
+    {
+        Datum* elements       = nullptr;
+        bool*  elements_nulls = nullptr;
+        int    elements_count = 0;
+
+        // ... the caller's vectors are alive, detoasting errors must travel as C++ exceptions ...
+        pg::cpp::utils::ErrorBridge::Call([fcinfo, a_arg, &elements, &elements_nulls, &elements_count] () {
+            deconstruct_array(PG_GETARG_ARRAYTYPE_P(a_arg), TEXTOID, -1, false, 'i', &elements, &elements_nulls, &elements_count);
+            for ( int idx = 0 ; idx < elements_count ; ++idx ) {
+                if ( false == elements_nulls[idx] ) {
+                    elements[idx] = PointerGetDatum(DatumGetTextPP(elements[idx]));
+                }
+            }
+        });
+
+        o_values.resize(static_cast<size_t>(elements_count));
+        o_nulls.resize(static_cast<size_t>(elements_count), false);
+        for ( int idx = 0 ; idx < elements_count ; ++idx ) {
+            if ( true == elements_nulls[idx] ) {
+                o_nulls[idx] = true;
+            } else {
+                o_values[idx] = pg_cpp_utils_text_view(reinterpret_cast<const text*>(DatumGetPointer(elements[idx])));
+            }
+        }
+    }
+
+    /**
+     * @brief pg-cpp-utils invoice hash interface to PostreSQL, one row per payload ( materialized ).
+     */
+    PG_CPP_UTILS_FUNCTION(pg_cpp_utils_invoice_hash_batch)
+    {
+        // ... test the number of arguments ...
+        const size_t args_count = PG_NARGS();
+        if ( 2 != args_count ) {
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_invoice_hash_batch(...) - received %zd argument(s), expected at least %d argument(s)!", args_count, 2);
+        }
+
+        // ... collect param(s) ...
+        text* tmp_pem_uri = PG_GETARG_TEXT_PP(0);
 
-            // ... build a tuple descriptor for our result type ...
-            TupleDesc tupdesc;
-            const TypeFuncClass return_type = get_call_result_type(fcinfo, NULL, &tupdesc);
-            if ( TYPEFUNC_COMPOSITE != return_type ) {
-                // ... restore context ...
-                MemoryContextSwitchTo(old_context);
-                // ... report error ....
-                ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmsg("Expecting result type %d ( TYPEFUNC_COMPOSITE ) not %d!", TYPEFUNC_COMPOSITE, return_type)));
-            }
-            func_call_context->attinmeta = TupleDescGetAttInMetadata(tupdesc);
+        const pg::cpp::utils::StringView pem_uri = pg_cpp_utils_text_view(tmp_pem_uri);
 
-            // ... create utility ...
-            pg::cpp::utils::Utility* utility = nullptr;
-            try {
-                utility = a_alloc_utility_func();
-                // ... perform ...
-                a_perform_func(utility);
-                const std::string& error = utility->LastError();
-                if ( error.length() > 0 ) {
-                    throw PG_CPP_UTILS_EXCEPTION("error code %s", error.c_str());
-                }
-                // ... allocate user func context ...
-                pg::cpp::utils::Utility::AllocUserFuncContext(func_call_context);
-                // ... set result data to function call context ...
-                utility->FillOutputAtUserFuncContext(func_call_context);
-            } catch (const pg::cpp::utils::Exception& a_pg_cpp_utils_exception) {
-                // ... release utility ...
-                a_dealloc_utility_func(utility);
-                // ... dealloc user func context ...
-                pg::cpp::utils::Utility::DeallocUserFuncContext(func_call_context);
-                // ... report error ...
-                ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmsg("%s", a_pg_cpp_utils_exception.what())));
-            } catch (...) {
-                // ... release utility ...
-                a_dealloc_utility_func(utility);
-                // ... dealloc user func context ...
-                pg::cpp::utils::Utility::DeallocUserFuncContext(func_call_context);
-                // ... report error ...
-                ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmsg("Unexpected exception generic caught!")));
-            }
+        const pg::cpp::utils::KeyCache::Source key_source = pg_cpp_utils_key_source(fcinfo, 0, pem_uri);
 
-            utility = a_dealloc_utility_func(utility);
+        std::vector<pg::cpp::utils::StringView> payloads;
+        std::vector<bool>                       payloads_nulls;
+        pg_cpp_utils_text_array(fcinfo, 1, payloads, payloads_nulls);
 
-            // ... restore context ...
-            MemoryContextSwitchTo(old_context);
+        // ... perform request ...
+        return pg_cpp_utils_utils_materialize<pg::cpp::utils::InvoiceHash>(fcinfo,
+                                                                           pg::cpp::utils::Stats::Function::InvoiceHashBatch,
+                                                                           /* allocation */
+                                                                           [&pem_uri, &key_source] (void* a_memory) -> pg::cpp::utils::InvoiceHash* {
+                                                                               return new (a_memory) pg::cpp::utils::InvoiceHash(pem_uri, key_source);
+                                                                           },
+                                                                           /* execute */
+                                                                           [&payloads, &payloads_nulls] (pg::cpp::utils::InvoiceHash& a_utility) -> void {
+                                                                               // ... prepare, hashes are calculated row by row or, with workers, all at once ...
+                                                                               a_utility.CalculateBatch(payloads, payloads_nulls,
+                                                                                                        static_cast<size_t>(s_sign_workers_));
+                                                                           }
+        );
+    }
+
+    /**
+     * @brief pg-cpp-utils invoice hash verification interface to PostreSQL
+     */
+    PG_CPP_UTILS_FUNCTION(pg_cpp_utils_invoice_hash_verify)
+    {
+        // ... test the number of arguments ...
+        const size_t args_count = PG_NARGS();
+        if ( 3 != args_count ) {
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_invoice_hash_verify(...) - received %zd argument(s), expected at least %d argument(s)!", args_count, 3);
         }
 
-        // ... stuff done on every call of the function ...
-        func_call_context = SRF_PERCALL_SETUP();
+        // ... collect param(s) ...
+        text* tmp_pem_uri   = PG_GETARG_TEXT_PP(0);
+        text* tmp_payload   = PG_GETARG_TEXT_PP(1);
+        text* tmp_long_hash = PG_GETARG_TEXT_PP(2);
 
-#ifdef __APPLE__
-    #define CALL_CNTR_FMT PRIu32
-#else
-    #define CALL_CNTR_FMT PRIu64
-#endif
+        const pg::cpp::utils::StringView pem_uri   = pg_cpp_utils_text_view(tmp_pem_uri);
 
-        // ... if still data rows to return ....
-        if ( func_call_context->call_cntr < func_call_context->max_calls ) {
+        const pg::cpp::utils::KeyCache::Source key_source = pg_cpp_utils_key_source(fcinfo, 0, pem_uri);
+        const pg::cpp::utils::StringView payload   = pg_cpp_utils_text_view(tmp_payload);
+        const pg::cpp::utils::StringView long_hash = pg_cpp_utils_text_view(tmp_long_hash);
 
-            // ... access user function call data ...
-            pg::cpp::utils::Utility::Records* records = static_cast<pg::cpp::utils::Utility::Records*>(func_call_context->user_fctx);
+        // ... perform request ...
+        return pg_cpp_utils_utils_common<pg::cpp::utils::InvoiceHash>(fcinfo,
+                                                                      pg::cpp::utils::Stats::Function::InvoiceHashVerify,
+                                                                      /* allocation */
+                                                                      [&pem_uri, &key_source] (void* a_memory) -> pg::cpp::utils::InvoiceHash* {
+                                                                          return new (a_memory) pg::cpp::utils::InvoiceHash(pem_uri, key_source);
+                                                                      },
+                                                                      /* execute */
+                                                                      [&payload, &long_hash] (pg::cpp::utils::InvoiceHash& a_utility) -> void {
+                                                                          // ... perform ...
+                                                                          a_utility.Verify(payload, long_hash);
+                                                                      }
+        );
+    }
 
-            // ... pick current row values ...
-            char** values = records->GetPStringValues(func_call_context->call_cntr);
-            // ... no data?
-            if ( nullptr == values ) {
-                // ... for debug proposes only ...
-                PG_CPP_UTILS_LOG_DEBUG("----- CALL #%" CALL_CNTR_FMT " ----- NO DATA", func_call_context->call_cntr);
-                // ... next ...
-                SRF_RETURN_NEXT_NULL(func_call_context);
-            }
+    /**
+     * @brief pg-cpp-utils invoice hash verification interface to PostreSQL, one row per payload / hash pair ( materialized ).
+     */
+    PG_CPP_UTILS_FUNCTION(pg_cpp_utils_invoice_hash_verify_batch)
+    {
+        // ... test the number of arguments ...
+        const size_t args_count = PG_NARGS();
+        if ( 3 != args_count ) {
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_invoice_hash_verify_batch(...) - received %zd argument(s), expected at least %d argument(s)!", args_count, 3);
+        }
 
-            // ... for debug proposes only ...
-            PG_CPP_UTILS_LOG_DEBUG("----- CALL #%" CALL_CNTR_FMT " ----- [%zd]: %s", func_call_context->call_cntr, strlen(values[0]), values[0]);
+        // ... collect param(s) ...
+        text* tmp_pem_uri = PG_GETARG_TEXT_PP(0);
 
-            //... build a tuple ....
-            HeapTuple tuple = BuildTupleFromCStrings(func_call_context->attinmeta, values);
+        const pg::cpp::utils::StringView pem_uri = pg_cpp_utils_text_view(tmp_pem_uri);
 
-            //... make the tuple into a datum ...
-            Datum result = HeapTupleGetDatum(tuple);
+        const pg::cpp::utils::KeyCache::Source key_source = pg_cpp_utils_key_source(fcinfo, 0, pem_uri);
 
-            // ... release record memory now ...
-            records->Release(func_call_context->call_cntr, values);
-            // ... next ...
-            SRF_RETURN_NEXT(func_call_context, result);
-        } else {
-            // ... dealloc user func context ...
-            pg::cpp::utils::Utility::DeallocUserFuncContext(func_call_context);
-            // ... for debug proposes only ...
-            PG_CPP_UTILS_LOG_DEBUG("----- %s -----", "FINAL_CALL");
-            // ... we're done ...
-            SRF_RETURN_DONE(func_call_context);
+        std::vector<pg::cpp::utils::StringView> payloads;
+        std::vector<pg::cpp::utils::StringView> long_hashes;
+        std::vector<bool>                       nulls;
+        pg_cpp_utils_text_array(fcinfo, 1, payloads, nulls);
+        pg_cpp_utils_text_array(fcinfo, 2, long_hashes, nulls);
+
+        if ( payloads.size() != long_hashes.size() ) {
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_invoice_hash_verify_batch(...) - received %zd payload(s) and %zd hash(es), expected the same number!", payloads.size(), long_hashes.size());
         }
 
+        // ... perform request ...
+        return pg_cpp_utils_utils_materialize<pg::cpp::utils::InvoiceHash>(fcinfo,
+                                                                           pg::cpp::utils::Stats::Function::InvoiceHashVerifyBatch,
+                                                                           /* allocation */
+                                                                           [&pem_uri, &key_source] (void* a_memory) -> pg::cpp::utils::InvoiceHash* {
+                                                                               return new (a_memory) pg::cpp::utils::InvoiceHash(pem_uri, key_source);
+                                                                           },
+                                                                           /* execute */
+                                                                           [&payloads, &long_hashes, &nulls] (pg::cpp::utils::InvoiceHash& a_utility) -> void {
+                                                                               // ... prepare, hashes are verified row by row ...
+                                                                               a_utility.VerifyBatch(payloads, long_hashes, nulls);
+                                                                           }
+        );
     }
 
     /**
-     * @brief pg-cpp-utils invoice hash interface to PostreSQL
-     *
-     * http://info.portaldasfinancas.gov.pt/NR/rdonlyres/89DB70CE-7BB5-417B-B13E-C72A912FF66E/0/Despacho_n_8632_2014_03_07.pdf
+     * @brief pg-cpp-utils signature interface to PostreSQL, see \link pg::cpp::utils::Signer::Algorithm \link.
      */
-    Datum pg_cpp_utils_invoice_hash (PG_FUNCTION_ARGS)
+    PG_CPP_UTILS_FUNCTION(pg_cpp_utils_sign)
     {
         // ... test the number of arguments ...
         const size_t args_count = PG_NARGS();
-        if ( 2 != args_count ) {
-            ereport(ERROR,
-                    (
-                     errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
-                     errmsg("pg_cpp_utils_invoice_hash(...) - received %zd argument(s), expected at least %d argument(s)!", args_count, 2)
-                    )
-            );
+        if ( 3 != args_count ) {
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_sign(...) - received %zd argument(s), expected at least %d argument(s)!", args_count, 3);
         }
 
         // ... collect param(s) ...
-        text* tmp_pem_uri         = PG_GETARG_TEXT_P(0);
-        text* tmp_payload         = PG_GETARG_TEXT_P(1);
+        text* tmp_key       = PG_GETARG_TEXT_PP(0);
+        text* tmp_payload   = PG_GETARG_TEXT_PP(1);
+        text* tmp_algorithm = PG_GETARG_TEXT_PP(2);
 
-        if ( nullptr == tmp_pem_uri ) {
-            ereport(ERROR,
-                    (
-                     errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
-                     errmsg("pg_cpp_utils_invoice_hash(...) - pem uri argument can not be null!")
-                     )
-            );
-        }
+        const pg::cpp::utils::StringView key       = pg_cpp_utils_text_view(tmp_key);
+        const pg::cpp::utils::StringView payload   = pg_cpp_utils_text_view(tmp_payload);
+        const pg::cpp::utils::StringView algorithm = pg_cpp_utils_text_view(tmp_algorithm);
 
-        if ( nullptr == tmp_payload ) {
-            ereport(ERROR,
-                    (
-                     errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
-                     errmsg("pg_cpp_utils_invoice_hash(...) - payload argument can not be null!")
-                    )
-            );
+        const pg::cpp::utils::KeyCache::Source key_source = pg_cpp_utils_key_source(fcinfo, 0, key);
+
+        // ... perform request ...
+        return pg_cpp_utils_utils_common<pg::cpp::utils::Signature>(fcinfo,
+                                                                    pg::cpp::utils::Stats::Function::Sign,
+                                                                    /* allocation */
+                                                                    [&key, &key_source, &algorithm] (void* a_memory) -> pg::cpp::utils::Signature* {
+                                                                        return new (a_memory) pg::cpp::utils::Signature(key, key_source, pg::cpp::utils::Signer::AlgorithmFromName(algorithm));
+                                                                    },
+                                                                    /* execute */
+                                                                    [&payload] (pg::cpp::utils::Signature& a_utility) -> void {
+                                                                        // ... perform ...
+                                                                        a_utility.Sign(payload);
+                                                                    }
+        );
+    }
+
+    /**
+     * @brief pg-cpp-utils signature verification interface to PostreSQL.
+     */
+    PG_CPP_UTILS_FUNCTION(pg_cpp_utils_sign_verify)
+    {
+        // ... test the number of arguments ...
+        const size_t args_count = PG_NARGS();
+        if ( 4 != args_count ) {
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_sign_verify(...) - received %zd argument(s), expected at least %d argument(s)!", args_count, 4);
         }
 
-        const std::string pem_uri = std::string(VARDATA(tmp_pem_uri) , VARSIZE(tmp_pem_uri)  - VARHDRSZ);
-        const std::string payload = std::string(VARDATA(tmp_payload) , VARSIZE(tmp_payload)  - VARHDRSZ);
+        // ... collect param(s) ...
+        text* tmp_key       = PG_GETARG_TEXT_PP(0);
+        text* tmp_payload   = PG_GETARG_TEXT_PP(1);
+        text* tmp_signature = PG_GETARG_TEXT_PP(2);
+        text* tmp_algorithm = PG_GETARG_TEXT_PP(3);
+
+        const pg::cpp::utils::StringView key       = pg_cpp_utils_text_view(tmp_key);
+        const pg::cpp::utils::StringView payload   = pg_cpp_utils_text_view(tmp_payload);
+        const pg::cpp::utils::StringView signature = pg_cpp_utils_text_view(tmp_signature);
+        const pg::cpp::utils::StringView algorithm = pg_cpp_utils_text_view(tmp_algorithm);
+
+        const pg::cpp::utils::KeyCache::Source key_source = pg_cpp_utils_key_source(fcinfo, 0, key);
 
         // ... perform request ...
-        return pg_cpp_utils_utils_common(fcinfo,
-                                /* allocation */
-                                [&pem_uri] () -> pg::cpp::utils::Utility* {
-                                    return new pg::cpp::utils::InvoiceHash(pem_uri);
-                                },
-                                /* execute */
-                                [&payload] (pg::cpp::utils::Utility* a_utility) -> void {
-                                    // ... perform ...
-                                    static_cast<pg::cpp::utils::InvoiceHash*>(a_utility)->Calculate(payload);
-                                },
-                                /* dealloc */
-                                [] (pg::cpp::utils::Utility* a_utility) -> pg::cpp::utils::Utility* {
-                                    delete a_utility;
-                                    return nullptr;
-                                }
+        return pg_cpp_utils_utils_common<pg::cpp::utils::Signature>(fcinfo,
+                                                                    pg::cpp::utils::Stats::Function::SignVerify,
+                                                                    /* allocation */
+                                                                    [&key, &key_source, &algorithm] (void* a_memory) -> pg::cpp::utils::Signature* {
+                                                                        return new (a_memory) pg::cpp::utils::Signature(key, key_source, pg::cpp::utils::Signer::AlgorithmFromName(algorithm));
+                                                                    },
+                                                                    /* execute */
+                                                                    [&payload, &signature] (pg::cpp::utils::Signature& a_utility) -> void {
+                                                                        // ... perform ...
+                                                                        a_utility.Verify(payload, signature);
+                                                                    }
         );
     }
 
     /**
      * @brief pg-cpp-utils invoice hash interface to PostreSQL
      */
-    Datum pg_cpp_utils_public_link (PG_FUNCTION_ARGS)
+    PG_CPP_UTILS_FUNCTION(pg_cpp_utils_public_link)
     {
         // ... test the number of arguments ...
         const size_t args_count = PG_NARGS();
         if ( 6 != args_count ) {
-            ereport(ERROR,
-                    (
-                     errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
-                     errmsg("pg_cpp_utils_public_link(...) - received %zd argument(s), expected at least %d argument(s)!", args_count, 6)
-                    )
-            );
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_public_link(...) - received %zd argument(s), expected at least %d argument(s)!", args_count, 6);
         }
 
         if ( PG_ARGISNULL(1) ) {
-            ereport(ERROR,
-                    (
-                     errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
-                     errmsg("pg_cpp_utils_public_link(...) - company id argument can not be null!")
-                     )
-            );
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_public_link(...) - company id argument can not be null!");
         }
 
         if ( PG_ARGISNULL(3) ) {
-            ereport(ERROR,
-                    (
-                     errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
-                     errmsg("pg_cpp_utils_public_link(...) - entity id argument can not be null!")
-                    )
-            );
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_public_link(...) - entity id argument can not be null!");
         }
 
         // ... collect param(s) ...
-        text*  tmp_base_url        = PG_GETARG_TEXT_P(0);
+        text*  tmp_base_url        = PG_GETARG_TEXT_PP(0);
         float8 tmp_company_id      = PG_GETARG_FLOAT8(1);
-        text*  tmp_entity_type     = PG_GETARG_TEXT_P(2);
+        text*  tmp_entity_type     = PG_GETARG_TEXT_PP(2);
         float8 tmp_entity_id       = PG_GETARG_FLOAT8(3);
-        text*  tmp_key             = PG_GETARG_TEXT_P(4);
-        text*  tmp_iv              = PG_GETARG_TEXT_P(5);
+        text*  tmp_key             = PG_GETARG_TEXT_PP(4);
+        text*  tmp_iv              = PG_GETARG_TEXT_PP(5);
 
         if ( nullptr == tmp_base_url ) {
-            ereport(ERROR,
-                    (
-                     errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
-                     errmsg("pg_cpp_utils_invoice_hash(...) - base url argument can not be null!")
-                    )
-            );
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_invoice_hash(...) - base url argument can not be null!");
         }
 
         if ( nullptr == tmp_entity_type ) {
-            ereport(ERROR,
-                    (
-                     errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
-                     errmsg("pg_cpp_utils_public_link(...) - entity type argument can not be null!")
-                    )
-            );
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_public_link(...) - entity type argument can not be null!");
         }
 
         if ( nullptr == tmp_key ) {
-            ereport(ERROR,
-                    (
-                     errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
-                     errmsg("pg_cpp_utils_public_link(...) - key argument can not be null!")
-                    )
-            );
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_public_link(...) - key argument can not be null!");
         }
 
         if ( nullptr == tmp_iv ) {
-            ereport(ERROR,
-                    (
-                     errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
-                     errmsg("pg_cpp_utils_public_link(...) - iv argument can not be null!")
-                    )
-            );
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_public_link(...) - iv argument can not be null!");
         }
 
         const int64_t company_id      = static_cast<int64_t>(tmp_company_id);
         const int64_t entity_id       = static_cast<int64_t>(tmp_entity_id);
 
-        const std::string base_url    = std::string(VARDATA(tmp_base_url)   , VARSIZE(tmp_base_url)    - VARHDRSZ);
-        const std::string entity_type = std::string(VARDATA(tmp_entity_type), VARSIZE(tmp_entity_type) - VARHDRSZ);
-        const std::string key         = std::string(VARDATA(tmp_key)        , VARSIZE(tmp_key)         - VARHDRSZ);
-        const std::string iv          = std::string(VARDATA(tmp_iv)         , VARSIZE(tmp_iv)          - VARHDRSZ);
+        const pg::cpp::utils::StringView base_url    = pg_cpp_utils_text_view(tmp_base_url);
+        const pg::cpp::utils::StringView entity_type = pg_cpp_utils_text_view(tmp_entity_type);
+        const pg::cpp::utils::StringView key         = pg_cpp_utils_text_view(tmp_key);
+        const pg::cpp::utils::StringView iv          = pg_cpp_utils_text_view(tmp_iv);
 
         // ... perform request ...
-        return pg_cpp_utils_utils_common(fcinfo,
-                                         /* allocation */
-                                         [&key, &iv] () -> pg::cpp::utils::Utility* {
-                                             return new pg::cpp::utils::PublicLink(key, iv);
-                                         },
-                                         /* execute */
-                                         [&base_url, &company_id, &entity_type, &entity_id] (pg::cpp::utils::Utility* a_utility) -> void {
-                                             // ... perform ...
-                                             static_cast<pg::cpp::utils::PublicLink*>(a_utility)->Calculate(base_url, company_id, entity_type, entity_id);
-                                         },
-                                         /* dealloc */
-                                         [] (pg::cpp::utils::Utility* a_utility) -> pg::cpp::utils::Utility* {
-                                             delete a_utility;
-                                             return nullptr;
-                                         }
+        return pg_cpp_utils_utils_common<pg::cpp::utils::PublicLink>(fcinfo,
+                                                                     pg::cpp::utils::Stats::Function::PublicLink,
+                                                                     /* allocation */
+                                                                     [&key, &iv] (void* a_memory) -> pg::cpp::utils::PublicLink* {
+                                                                         return new (a_memory) pg::cpp::utils::PublicLink(key, iv);
+                                                                     },
+                                                                     /* execute */
+                                                                     [&base_url, &company_id, &entity_type, &entity_id] (pg::cpp::utils::PublicLink& a_utility) -> void {
+                                                                         // ... perform ...
+                                                                         a_utility.Calculate(base_url, company_id, entity_type, entity_id);
+                                                                     }
         );
     }
 
     /**
      * @brief pg-cpp-utils number to words interface to PostreSQL
      */
-    Datum pg_cpp_utils_number_spellout (PG_FUNCTION_ARGS)
+    PG_CPP_UTILS_FUNCTION(pg_cpp_utils_number_spellout)
     {
         // ... test the number of arguments ...
         const size_t args_count = PG_NARGS();
         if ( args_count < 2 ) {
-            ereport(ERROR,
-                    (
-                     errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
-                     errmsg("pg_cpp_utils_number_spellout(...) - received %zd argument(s), expected at least %d argument(s)!", args_count, 2)
-                    )
-            );
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_number_spellout(...) - received %zd argument(s), expected at least %d argument(s)!", args_count, 2);
         }
 
         // ... collect param(s) ...
-        text*  tmp_locale = PG_GETARG_TEXT_P(0);
+        text*  tmp_locale = PG_GETARG_TEXT_PP(0);
         float8 tmp_number = PG_GETARG_FLOAT8(1);
 
-        const std::string locale            = tmp_locale ? std::string(VARDATA(tmp_locale) , VARSIZE(tmp_locale)  - VARHDRSZ) : "en_US";
-        const double      number            = PG_ARGISNULL(1) ?     0.0 : tmp_number;
+        const pg::cpp::utils::StringView locale = tmp_locale ? pg_cpp_utils_text_view(tmp_locale) : "en_US";
+        const double                     number = PG_ARGISNULL(1) ?     0.0 : tmp_number;
 
-        std::string spellout_override;
+        pg::cpp::utils::StringView spellout_override;
         if ( args_count >= 2 && 0 == PG_ARGISNULL(2) ) {
-            text*  tmp_override = PG_GETARG_TEXT_P(2);
-            if ( ( VARSIZE(tmp_override) - VARHDRSZ ) > 0 ) {
-                spellout_override = std::string(VARDATA(tmp_override), VARSIZE(tmp_override) - VARHDRSZ);
+            text*  tmp_override = PG_GETARG_TEXT_PP(2);
+            if ( VARSIZE_ANY_EXHDR(tmp_override) > 0 ) {
+                spellout_override = pg_cpp_utils_text_view(tmp_override);
             }
         }
 
+        pg::cpp::utils::StringView rule_set;
+        if ( args_count >= 4 && 0 == PG_ARGISNULL(3) ) {
+            rule_set = pg_cpp_utils_text_view(PG_GETARG_TEXT_PP(3));
+        }
+
+        // ... a named rule set is read from it's table before calling ICU ...
+        pg_cpp_utils_spellout_rules_load(fcinfo, spellout_override);
+
         // ... perform request ...
-        return pg_cpp_utils_utils_common(fcinfo,
-                                         /* allocation */
-                                         [&locale, &spellout_override] () -> pg::cpp::utils::Utility* {
-                                             UErrorCode icu_error_code = UErrorCode::U_ZERO_ERROR;
-                                             u_init(&icu_error_code);
-                                             if ( UErrorCode::U_ZERO_ERROR != icu_error_code ) {
-                                                 throw PG_CPP_UTILS_EXCEPTION("ICU initialization error code %d", icu_error_code);
-                                             }
-                                             return new pg::cpp::utils::NumberSpellout(locale, spellout_override);
-                                         },
-                                         /* execute */
-                                         [&number] (pg::cpp::utils::Utility* a_utility) -> void {
-                                             // ... perform ...
-                                             static_cast<pg::cpp::utils::NumberSpellout*>(a_utility)->Spellout(number);
-                                         },
-                                         /* dealloc */
-                                         [] (pg::cpp::utils::Utility* a_utility) -> pg::cpp::utils::Utility* {
-                                             delete a_utility;
-                                             u_cleanup();
-                                             return nullptr;
-                                         }
+        return pg_cpp_utils_utils_common<pg::cpp::utils::NumberSpellout>(fcinfo,
+                                                                         pg::cpp::utils::Stats::Function::NumberSpellout,
+                                                                         /* allocation */
+                                                                         [&locale, &spellout_override, &rule_set] (void* a_memory) -> pg::cpp::utils::NumberSpellout* {
+                                                                             UErrorCode icu_error_code = UErrorCode::U_ZERO_ERROR;
+                                                                             u_init(&icu_error_code);
+                                                                             if ( UErrorCode::U_ZERO_ERROR != icu_error_code ) {
+                                                                                 throw PG_CPP_UTILS_EXCEPTION("ICU initialization error code %d", icu_error_code);
+                                                                             }
+                                                                             return new (a_memory) pg::cpp::utils::NumberSpellout(locale, spellout_override, rule_set);
+                                                                         },
+                                                                         /* execute */
+                                                                         [&number] (pg::cpp::utils::NumberSpellout& a_utility) -> void {
+                                                                             // ... perform ...
+                                                                             a_utility.Spellout(number);
+                                                                         },
+                                                                         /* binding */
+                                                                         pg_cpp_utils_binding({ locale, spellout_override, rule_set, std::to_string(s_spellout_rules_generation_) })
         );
 
     }
 
+    /**
+     * @brief pg-cpp-utils numbers to words interface to PostreSQL, one row per array element ( value-per-call ).
+     */
+    PG_CPP_UTILS_FUNCTION(pg_cpp_utils_number_spellout_batch)
+    {
+        // ... test the number of arguments ...
+        const size_t args_count = PG_NARGS();
+        if ( args_count < 2 ) {
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_number_spellout_batch(...) - received %zd argument(s), expected at least %d argument(s)!", args_count, 2);
+        }
+
+        // ... a named rule set is read from it's table before calling ICU - fn_extra is the call site here, not the SRF state,
+        //     so it's checked on every call: a rescan may bring another override, or rules loaded again after a change ...
+        if ( args_count >= 3 && 0 == PG_ARGISNULL(2) ) {
+            pg_cpp_utils_spellout_rules_load(fcinfo, pg_cpp_utils_text_view(PG_GETARG_TEXT_PP(2)));
+        }
+
+        // ... param(s) are only collected on the first call ...
+        return pg_cpp_utils_utils_value_per_call<pg::cpp::utils::NumberSpellout>(fcinfo,
+                                                                                 pg::cpp::utils::Stats::Function::NumberSpelloutBatch,
+                                                                                 /* allocation */
+                                                                                 [fcinfo, args_count] (void* a_memory) -> pg::cpp::utils::NumberSpellout* {
+                                                                                     text* tmp_locale = PG_GETARG_TEXT_PP(0);
+
+                                                                                     const pg::cpp::utils::StringView locale = pg_cpp_utils_text_view(tmp_locale);
+
+                                                                                     pg::cpp::utils::StringView spellout_override;
+                                                                                     if ( args_count >= 3 && 0 == PG_ARGISNULL(2) ) {
+                                                                                         text* tmp_override = PG_GETARG_TEXT_PP(2);
+                                                                                         if ( VARSIZE_ANY_EXHDR(tmp_override) > 0 ) {
+                                                                                             spellout_override = pg_cpp_utils_text_view(tmp_override);
+                                                                                         }
+                                                                                     }
+
+                                                                                     pg::cpp::utils::StringView rule_set;
+                                                                                     if ( args_count >= 4 && 0 == PG_ARGISNULL(3) ) {
+                                                                                         rule_set = pg_cpp_utils_text_view(PG_GETARG_TEXT_PP(3));
+                                                                                     }
+
+                                                                                     UErrorCode icu_error_code = UErrorCode::U_ZERO_ERROR;
+                                                                                     u_init(&icu_error_code);
+                                                                                     if ( UErrorCode::U_ZERO_ERROR != icu_error_code ) {
+                                                                                         throw PG_CPP_UTILS_EXCEPTION("ICU initialization error code %d", icu_error_code);
+                                                                                     }
+                                                                                     return new (a_memory) pg::cpp::utils::NumberSpellout(locale, spellout_override, rule_set);
+                                                                                 },
+                                                                                 /* execute */
+                                                                                 [fcinfo] (pg::cpp::utils::NumberSpellout& a_utility) -> void {
+                                                                                     ArrayType* tmp_numbers    = PG_GETARG_ARRAYTYPE_P(1);
+                                                                                     Datum*     elements       = nullptr;
+                                                                                     bool*      elements_nulls = nullptr;
+                                                                                     int        elements_count = 0;
+                                                                                     deconstruct_array(tmp_numbers, FLOAT8OID, sizeof(float8), FLOAT8PASSBYVAL, 'd', &elements, &elements_nulls, &elements_count);
+
+                                                                                     std::vector<double> numbers(static_cast<size_t>(elements_count));
+                                                                                     std::vector<bool>   numbers_nulls(static_cast<size_t>(elements_count));
+                                                                                     for ( int idx = 0 ; idx < elements_count ; ++idx ) {
+                                                                                         numbers_nulls[idx] = elements_nulls[idx];
+                                                                                         numbers[idx]       = ( elements_nulls[idx] ? 0.0 : DatumGetFloat8(elements[idx]) );
+                                                                                     }
+
+                                                                                     // ... prepare, numbers are spelled out row by row ...
+                                                                                     a_utility.SpelloutBatch(numbers, numbers_nulls);
+                                                                                 }
+        );
+    }
+
     /**
      * @brief pg-cpp-utils currency to words interface to PostreSQL
      */
-    Datum pg_cpp_utils_currency_spellout (PG_FUNCTION_ARGS)
+    PG_CPP_UTILS_FUNCTION(pg_cpp_utils_currency_spellout)
     {
         // ... test the number of arguments ...
         const size_t args_count = PG_NARGS();
         if ( args_count < 8 ) {
-            ereport(ERROR,
-                    (
-                     errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
-                     errmsg("pg_cpp_utils_currency_spellout(...) - received %zd argument(s), expected at least %d argument(s)!", args_count, 8)
-                    )
-            );
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_currency_spellout(...) - received %zd argument(s), expected at least %d argument(s)!", args_count, 8);
         }
 
         // ... collect param(s) ...
 
-        text*  tmp_locale         = PG_GETARG_TEXT_P(0);
+        text*  tmp_locale         = PG_GETARG_TEXT_PP(0);
         float8 tmp_major          = PG_ARGISNULL(1) ? 0.0 : PG_GETARG_FLOAT8(1);
-        text*  tmp_major_singular = PG_GETARG_TEXT_P(2);
-        text*  tmp_major_plural   = PG_GETARG_TEXT_P(3);
+        text*  tmp_major_singular = PG_GETARG_TEXT_PP(2);
+        text*  tmp_major_plural   = PG_GETARG_TEXT_PP(3);
         float8 tmp_minor          = PG_ARGISNULL(4) ? 0.0 : PG_GETARG_FLOAT8(4);
-        text*  tmp_minor_singular = PG_GETARG_TEXT_P(5);
-        text*  tmp_minor_plural   = PG_GETARG_TEXT_P(6);
-        text*  tmp_format         = PG_GETARG_TEXT_P(7);
-
-        const std::string locale            = PG_ARGISNULL(0) ? "pt_PT" : std::string(VARDATA(tmp_locale)        , VARSIZE(tmp_locale)         - VARHDRSZ);
-        const std::string major_singular    = PG_ARGISNULL(2) ? ""      : std::string(VARDATA(tmp_major_singular), VARSIZE(tmp_major_singular) - VARHDRSZ);
-        const std::string major_plural      = PG_ARGISNULL(3) ? ""      : std::string(VARDATA(tmp_major_plural)  , VARSIZE(tmp_major_plural)   - VARHDRSZ);
-        const std::string minor_singular    = PG_ARGISNULL(5) ? ""      : std::string(VARDATA(tmp_minor_singular), VARSIZE(tmp_minor_singular) - VARHDRSZ);
-        const std::string minor_plural      = PG_ARGISNULL(6) ? ""      : std::string(VARDATA(tmp_minor_plural)  , VARSIZE(tmp_minor_plural)   - VARHDRSZ);
-        const std::string format            = PG_ARGISNULL(7) ? ""      : std::string(VARDATA(tmp_format)        , VARSIZE(tmp_format)         - VARHDRSZ);
-
-        std::string spellout_override;
+        text*  tmp_minor_singular = PG_GETARG_TEXT_PP(5);
+        text*  tmp_minor_plural   = PG_GETARG_TEXT_PP(6);
+        text*  tmp_format         = PG_GETARG_TEXT_PP(7);
+
+        const pg::cpp::utils::StringView locale            = PG_ARGISNULL(0) ? "pt_PT" : pg_cpp_utils_text_view(tmp_locale);
+        const pg::cpp::utils::StringView major_singular    = PG_ARGISNULL(2) ? ""      : pg_cpp_utils_text_view(tmp_major_singular);
+        const pg::cpp::utils::StringView major_plural      = PG_ARGISNULL(3) ? ""      : pg_cpp_utils_text_view(tmp_major_plural);
+        const pg::cpp::utils::StringView minor_singular    = PG_ARGISNULL(5) ? ""      : pg_cpp_utils_text_view(tmp_minor_singular);
+        const pg::cpp::utils::StringView minor_plural      = PG_ARGISNULL(6) ? ""      : pg_cpp_utils_text_view(tmp_minor_plural);
+        const pg::cpp::utils::StringView format            = PG_ARGISNULL(7) ? ""      : pg_cpp_utils_text_view(tmp_format);
+
+        pg::cpp::utils::StringView spellout_override;
         if ( args_count >= 9 && 0 == PG_ARGISNULL(8) ) {
-            text*  tmp_override = PG_GETARG_TEXT_P(8);
-            if ( ( VARSIZE(tmp_override) - VARHDRSZ ) > 0 ) {
-                spellout_override = std::string(VARDATA(tmp_override), VARSIZE(tmp_override) - VARHDRSZ);
+            text*  tmp_override = PG_GETARG_TEXT_PP(8);
+            if ( VARSIZE_ANY_EXHDR(tmp_override) > 0 ) {
+                spellout_override = pg_cpp_utils_text_view(tmp_override);
             }
         }
 
+        pg::cpp::utils::StringView rule_set;
+        if ( args_count >= 10 && 0 == PG_ARGISNULL(9) ) {
+            rule_set = pg_cpp_utils_text_view(PG_GETARG_TEXT_PP(9));
+        }
+
         const double major = tmp_major;
         const double minor = tmp_minor;
 
+        // ... a named rule set is read from it's table before calling ICU ...
+        pg_cpp_utils_spellout_rules_load(fcinfo, spellout_override);
+
         // ... perform request ...
-        return pg_cpp_utils_utils_common(fcinfo,
-                                         /* allocation */
-                                         [&locale, &spellout_override] () -> pg::cpp::utils::Utility* {
-                                             UErrorCode icu_error_code = UErrorCode::U_ZERO_ERROR;
-                                             u_init(&icu_error_code);
-                                             if ( UErrorCode::U_ZERO_ERROR != icu_error_code ) {
-                                                 throw PG_CPP_UTILS_EXCEPTION("ICU initialization error code %d", icu_error_code);
-                                             }
-                                             return new pg::cpp::utils::NumberSpellout(locale, spellout_override);
-                                         },
-                                         /* execute */
-                                         [&major, &major_singular, &major_plural, &minor, &minor_singular, &minor_plural, &format] (pg::cpp::utils::Utility* a_utility) -> void {
-                                             // ... perform ...
-                                             static_cast<pg::cpp::utils::NumberSpellout*>(a_utility)->CurrencySpellout(major, major_singular, major_plural,
-                                                                                                                       minor, minor_singular, minor_plural,
-                                                                                                                       format
-                                            );
-                                         },
-                                         /* dealloc */
-                                         [] (pg::cpp::utils::Utility* a_utility) -> pg::cpp::utils::Utility* {
-                                             delete a_utility;
-                                             u_cleanup();
-                                             return nullptr;
-                                         }
+        return pg_cpp_utils_utils_common<pg::cpp::utils::NumberSpellout>(fcinfo,
+                                                                         pg::cpp::utils::Stats::Function::CurrencySpellout,
+                                                                         /* allocation */
+                                                                         [&locale, &spellout_override, &rule_set] (void* a_memory) -> pg::cpp::utils::NumberSpellout* {
+                                                                             UErrorCode icu_error_code = UErrorCode::U_ZERO_ERROR;
+                                                                             u_init(&icu_error_code);
+                                                                             if ( UErrorCode::U_ZERO_ERROR != icu_error_code ) {
+                                                                                 throw PG_CPP_UTILS_EXCEPTION("ICU initialization error code %d", icu_error_code);
+                                                                             }
+                                                                             return new (a_memory) pg::cpp::utils::NumberSpellout(locale, spellout_override, rule_set);
+                                                                         },
+                                                                         /* execute */
+                                                                         [&major, &major_singular, &major_plural, &minor, &minor_singular, &minor_plural, &format] (pg::cpp::utils::NumberSpellout& a_utility) -> void {
+                                                                             // ... perform ...
+                                                                             a_utility.CurrencySpellout(major, major_singular, major_plural,
+                                                                                                        minor, minor_singular, minor_plural,
+                                                                                                        format);
+                                                                         },
+                                                                         /* binding */
+                                                                         pg_cpp_utils_binding({ locale, spellout_override, rule_set, std::to_string(s_spellout_rules_generation_) })
+        );
+    }
+
+    /**
+     * @brief pg-cpp-utils register ( or replace ) a named spellout rule set for a locale.
+     */
+    PG_CPP_UTILS_FUNCTION(pg_cpp_utils_register_spellout_rules)
+    {
+        // ... test the number of arguments ...
+        const size_t args_count = PG_NARGS();
+        if ( 3 != args_count ) {
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_register_spellout_rules(...) - received %zd argument(s), expected %d argument(s)!", args_count, 3);
+        }
+
+        for ( size_t idx = 0 ; idx < args_count ; ++idx ) {
+            if ( 1 == PG_ARGISNULL(idx) ) {
+                throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_register_spellout_rules(...) - argument #%zd can not be null!", idx + 1);
+            }
+        }
+
+        // ... collect param(s) ...
+
+        const pg::cpp::utils::StringView name   = pg_cpp_utils_text_view(PG_GETARG_TEXT_PP(0));
+        const pg::cpp::utils::StringView locale = pg_cpp_utils_text_view(PG_GETARG_TEXT_PP(1));
+        const pg::cpp::utils::StringView rules  = pg_cpp_utils_text_view(PG_GETARG_TEXT_PP(2));
+
+        if ( false == pg::cpp::utils::SpelloutRules::IsName(name) ) {
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_INVALID_PARAMETER_VALUE, "pg_cpp_utils_register_spellout_rules(...) - name must be 1 to 63 letters, digits, '_', '.' or '-'!");
+        }
+
+        // ... rules ICU can't compile never reach the table ...
+        try {
+            pg::cpp::utils::SpelloutRules::Validate(locale, rules);
+        } catch (const pg::cpp::utils::Exception& a_pg_cpp_utils_exception) {
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_INVALID_PARAMETER_VALUE, "%s", a_pg_cpp_utils_exception.what());
+        }
+
+        // ... upsert, the table's trigger invalidates loaded rule sets on commit ...
+        StringInfoData query;
+        initStringInfo(&query);
+        appendStringInfo(&query,
+                         "INSERT INTO %s (name, locale, rules) VALUES ($1, $2, $3)"
+                         " ON CONFLICT (name, locale) DO UPDATE SET rules = EXCLUDED.rules",
+                         pg_cpp_utils_spellout_rules_table(fcinfo)
         );
+
+        Oid   arg_types[3]  = { TEXTOID, TEXTOID, TEXTOID };
+        Datum arg_values[3] = { PG_GETARG_DATUM(0), PG_GETARG_DATUM(1), PG_GETARG_DATUM(2) };
+
+        SPI_connect();
+        const int rv = SPI_execute_with_args(query.data, 3, arg_types, arg_values, /* a_nulls */ NULL, /* a_read_only */ false, 0);
+        SPI_finish();
+        if ( SPI_OK_INSERT != rv ) {
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_INTERNAL_ERROR, "pg_cpp_utils_register_spellout_rules(...) - unable to write rule set, SPI error %d!", rv);
+        }
+
+        PG_RETURN_VOID();
+    }
+
+    /**
+     * @brief pg_cpp_utils_spellout_rules statement trigger: once the change commits, all backends forget the rule sets
+     *        they loaded ( see pg_cpp_utils_spellout_rules_relcache_callback ).
+     */
+    PG_CPP_UTILS_FUNCTION(pg_cpp_utils_spellout_rules_invalidate)
+    {
+        if ( false == CALLED_AS_TRIGGER(fcinfo) ) {
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_E_R_I_E_TRIGGER_PROTOCOL_VIOLATED, "pg_cpp_utils_spellout_rules_invalidate(...) - not called by trigger manager!");
+        }
+
+        CacheInvalidateRelcache(reinterpret_cast<TriggerData*>(fcinfo->context)->tg_relation);
+
+        return PointerGetDatum(NULL);
     }
 
     /**
      * @brief pg-cpp-utils currency to words interface to PostreSQL
      */
-    Datum pg_cpp_utils_format_number (PG_FUNCTION_ARGS)
+    PG_CPP_UTILS_FUNCTION(pg_cpp_utils_format_number)
     {
         // ... test the number of arguments ...
         const size_t args_count = PG_NARGS();
         if ( args_count < 3 ) {
-            ereport(ERROR,
-                    (
-                     errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
-                     errmsg("pg_cpp_utils_format_number(...) - received %zd argument(s), expected at least %d argument(s)!", args_count, 3)
-                     )
-            );
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_format_number(...) - received %zd argument(s), expected at least %d argument(s)!", args_count, 3);
         }
 
         if ( 1 == PG_ARGISNULL(0) ) {
-            ereport(ERROR,
-                    (
-                     errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
-                     errmsg("pg_cpp_utils_format_number(...) - value argument can not be null!")
-                     )
-            );
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_format_number(...) - value argument can not be null!");
         }
 
         if ( 1 == PG_ARGISNULL(1) ) {
-            ereport(ERROR,
-                    (
-                     errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
-                     errmsg("pg_cpp_utils_format_number(...) - pattern argument can not be null!")
-                     )
-            );
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_format_number(...) - pattern argument can not be null!");
         }
 
         if ( 1 == PG_ARGISNULL(2) ) {
-            ereport(ERROR,
-                    (
-                     errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
-                     errmsg("pg_cpp_utils_format_number(...) - locale argument can not be null!")
-                     )
-            );
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_format_number(...) - locale argument can not be null!");
         }
 
         // ... collect param(s) ...
 
-        text*  tmp_locale  = PG_GETARG_TEXT_P(0);
+        text*  tmp_locale  = PG_GETARG_TEXT_PP(0);
         float8 tmp_value   = PG_GETARG_FLOAT8(1);
-        text*  tmp_pattern = PG_GETARG_TEXT_P(2);
+        text*  tmp_pattern = PG_GETARG_TEXT_PP(2);
 
         const double      value   = tmp_value;
-        const std::string pattern = std::string(VARDATA(tmp_pattern), VARSIZE(tmp_pattern) - VARHDRSZ);
-        const std::string locale  = std::string(VARDATA(tmp_locale), VARSIZE(tmp_locale) - VARHDRSZ);
+        const pg::cpp::utils::StringView pattern = pg_cpp_utils_text_view(tmp_pattern);
+        const pg::cpp::utils::StringView locale  = pg_cpp_utils_text_view(tmp_locale);
 
         // ... perform request ...
-        return pg_cpp_utils_utils_common(fcinfo,
-                                         /* allocation */
-                                         [&locale] () -> pg::cpp::utils::Utility* {
-                                             UErrorCode icu_error_code = UErrorCode::U_ZERO_ERROR;
-                                             u_init(&icu_error_code);
-                                             if ( UErrorCode::U_ZERO_ERROR != icu_error_code ) {
-                                                 throw PG_CPP_UTILS_EXCEPTION("ICU initialization error code %d", icu_error_code);
-                                             }
-                                             return new pg::cpp::utils::NumberFormatter(locale);
-                                         },
-                                         /* execute */
-                                         [&value, &pattern] (pg::cpp::utils::Utility* a_utility) -> void {
-                                             // ... perform ...
-                                             static_cast<pg::cpp::utils::NumberFormatter*>(a_utility)->Format(value, pattern);
-                                         },
-                                         /* dealloc */
-                                         [] (pg::cpp::utils::Utility* a_utility) -> pg::cpp::utils::Utility* {
-                                             delete a_utility;
-                                             u_cleanup();
-                                             return nullptr;
-                                         }
+        return pg_cpp_utils_utils_common<pg::cpp::utils::NumberFormatter>(fcinfo,
+                                                                          pg::cpp::utils::Stats::Function::FormatNumber,
+                                                                          /* allocation */
+                                                                          [&locale] (void* a_memory) -> pg::cpp::utils::NumberFormatter* {
+                                                                              UErrorCode icu_error_code = UErrorCode::U_ZERO_ERROR;
+                                                                              u_init(&icu_error_code);
+                                                                              if ( UErrorCode::U_ZERO_ERROR != icu_error_code ) {
+                                                                                  throw PG_CPP_UTILS_EXCEPTION("ICU initialization error code %d", icu_error_code);
+                                                                              }
+                                                                              return new (a_memory) pg::cpp::utils::NumberFormatter(locale);
+                                                                          },
+                                                                          /* execute */
+                                                                          [&value, &pattern] (pg::cpp::utils::NumberFormatter& a_utility) -> void {
+                                                                              // ... perform ...
+                                                                              a_utility.Format(value, pattern);
+                                                                          },
+                                                                          /* binding */
+                                                                          pg_cpp_utils_binding({ locale })
         );
     }
 
     /**
      * @brief pg-cpp-utils format a message
      */
-    Datum pg_cpp_utils_format_message (PG_FUNCTION_ARGS)
+    PG_CPP_UTILS_FUNCTION(pg_cpp_utils_format_message)
     {
         // ... test the number of arguments ...
         const size_t args_count = PG_NARGS();
         if ( args_count < 3 ) {
-            ereport(ERROR,
-                    (
-                     errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
-                     errmsg("pg_cpp_utils_format_message(...) - received %zd argument(s), expected at least %d argument(s)!", args_count, 3)
-                    )
-            );
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_format_message(...) - received %zd argument(s), expected at least %d argument(s)!", args_count, 3);
         }
 
         if ( 1 == PG_ARGISNULL(0) ) {
-            ereport(ERROR,
-                    (
-                     errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
-                     errmsg("pg_cpp_utils_format_message(...) - locale argument can not be null!")
-                )
-            );
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_format_message(...) - locale argument can not be null!");
         }
 
         if ( 1 == PG_ARGISNULL(1) ) {
-            ereport(ERROR,
-                    (
-                     errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
-                     errmsg("pg_cpp_utils_format_message(...) - key argument can not be null!")
-                )
-            );
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_format_message(...) - key argument can not be null!");
         }
 
         if ( 1 == PG_ARGISNULL(2) ) {
-            ereport(ERROR,
-                    (
-                     errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
-                     errmsg("pg_cpp_utils_format_message(...) - args arguments can not be null!")
-                )
-            );
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_format_message(...) - args arguments can not be null!");
         }
 
         // ... collect param(s) ...
 
-        text*      tmp_locale = PG_GETARG_TEXT_P(0);
-        text*      tmp_key    = PG_GETARG_TEXT_P(1);
+        text*      tmp_locale = PG_GETARG_TEXT_PP(0);
+        text*      tmp_key    = PG_GETARG_TEXT_PP(1);
         ArrayType* in_array   = PG_GETARG_ARRAYTYPE_P(2);
 
         if ( TEXTOID != ARR_ELEMTYPE(in_array) ) {
-            ereport(ERROR,
-                    (
-                     errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
-                     errmsg("pg_cpp_utils_format_message(...) - arguments array must be type cstring[]!")
-                    )
-            );
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_format_message(...) - arguments array must be type cstring[]!");
         }
 
         if ( 1 != ARR_NDIM(in_array) ) {
-            ereport(ERROR,
-                    (
-                     errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
-                     errmsg("pg_cpp_utils_format_message(...) - arguments array must be one-dimensional!")
-                    )
-            );
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_format_message(...) - arguments array must be one-dimensional!");
         }
 
         if ( array_contains_nulls(in_array) ) {
-            ereport(ERROR,
-                    (
-                     errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
-                     errmsg("pg_cpp_utils_format_message(...) - arguments array must not contain nulls!")
-                    )
-            );
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_format_message(...) - arguments array must not contain nulls!");
         }
 
-        const std::string        locale = std::string(VARDATA(tmp_locale), VARSIZE(tmp_locale) - VARHDRSZ);
-        const std::string        format = std::string(VARDATA(tmp_key), VARSIZE(tmp_key) - VARHDRSZ);
-        std::vector<std::string> args;
+        const pg::cpp::utils::StringView locale = pg_cpp_utils_text_view(tmp_locale);
+        const pg::cpp::utils::StringView format = pg_cpp_utils_text_view(tmp_key);
 
         Datum* in_datums = nullptr;
         int    in_count  = 0;
         /* hardwired knowledge about cstring's representation details here */
         deconstruct_array(in_array, TEXTOID, -1, false, 'i', &in_datums, /* &in_nulls */ nullptr, &in_count);
+        // ... detoasted before any C++ state is alive ...
+        for ( int idx = 0; idx < in_count; ++idx ) {
+            in_datums[idx] = PointerGetDatum(DatumGetTextPP(in_datums[idx]));
+        }
+
+        std::vector<pg::cpp::utils::StringView> args;
+        args.reserve(static_cast<size_t>(in_count));
         for ( int idx = 0; idx < in_count; ++idx ) {
-            char* c_str = TextDatumGetCString(in_datums[idx]);
-            args.push_back(c_str);
-            pfree(c_str);
+            args.push_back(pg_cpp_utils_text_view(reinterpret_cast<const text*>(DatumGetPointer(in_datums[idx]))));
         }
-        pfree(in_datums);
 
         // ... perform request ...
-        return pg_cpp_utils_utils_common(fcinfo,
-                                         /* allocation */
-                                         [&locale] () -> pg::cpp::utils::Utility* {
-                                             UErrorCode icu_error_code = UErrorCode::U_ZERO_ERROR;
-                                             u_init(&icu_error_code);
-                                             if ( UErrorCode::U_ZERO_ERROR != icu_error_code ) {
-                                                 throw PG_CPP_UTILS_EXCEPTION("ICU initialization error code %d", icu_error_code);
-                                             }
-                                             return new pg::cpp::utils::MessageFormatter(locale);
-                                         },
-                                         /* execute */
-                                         [&format, &args] (pg::cpp::utils::Utility* a_utility) -> void {
-                                             // ... perform ...
-                                             static_cast<pg::cpp::utils::MessageFormatter*>(a_utility)->Format(format, args);
-                                         },
-                                         /* dealloc */
-                                         [] (pg::cpp::utils::Utility* a_utility) -> pg::cpp::utils::Utility* {
-                                             delete a_utility;
-                                             u_cleanup();
-                                             return nullptr;
-                                         }
+        return pg_cpp_utils_utils_common<pg::cpp::utils::MessageFormatter>(fcinfo,
+                                                                           pg::cpp::utils::Stats::Function::FormatMessage,
+                                                                           /* allocation */
+                                                                           [&locale] (void* a_memory) -> pg::cpp::utils::MessageFormatter* {
+                                                                               UErrorCode icu_error_code = UErrorCode::U_ZERO_ERROR;
+                                                                               u_init(&icu_error_code);
+                                                                               if ( UErrorCode::U_ZERO_ERROR != icu_error_code ) {
+                                                                                   throw PG_CPP_UTILS_EXCEPTION("ICU initialization error code %d", icu_error_code);
+                                                                               }
+                                                                               return new (a_memory) pg::cpp::utils::MessageFormatter(locale);
+                                                                           },
+                                                                           /* execute */
+                                                                           [&format, &args] (pg::cpp::utils::MessageFormatter& a_utility) -> void {
+                                                                               // ... perform ...
+                                                                               a_utility.Format(format, args);
+                                                                           },
+                                                                           /* binding */
+                                                                           pg_cpp_utils_binding({ locale })
+        );
+    }
+
+    /**
+     * @brief Map a pg_cpp_utils_format_message_typed argument to a message formatter argument, numbers and dates
+     *        keep their type, anything else is passed as text.
+     *
+     * @param a_type
+     * @param a_value
+     * @param o_arg
+     */
+    static void pg_cpp_utils_message_argument (const Oid a_type, const Datum a_value, pg::cpp::utils::MessageFormatter::Argument& o_arg)
+    {
+        // ... milliseconds from 1970-01-01 to 2000-01-01, PostgreSQL's epoch ...
+        static const double k_pg_epoch_ms_ = static_cast<double>(POSTGRES_EPOCH_JDATE - UNIX_EPOCH_JDATE) * SECS_PER_DAY * 1000.0;
+
+        o_arg.type_   = pg::cpp::utils::MessageFormatter::ArgumentType::String;
+        o_arg.int64_  = 0;
+        o_arg.double_ = 0;
+
+        switch ( a_type ) {
+            case INT2OID:
+                o_arg.type_  = pg::cpp::utils::MessageFormatter::ArgumentType::Int64;
+                o_arg.int64_ = DatumGetInt16(a_value);
+                break;
+            case INT4OID:
+                o_arg.type_  = pg::cpp::utils::MessageFormatter::ArgumentType::Int64;
+                o_arg.int64_ = DatumGetInt32(a_value);
+                break;
+            case INT8OID:
+                o_arg.type_  = pg::cpp::utils::MessageFormatter::ArgumentType::Int64;
+                o_arg.int64_ = DatumGetInt64(a_value);
+                break;
+            case FLOAT4OID:
+                o_arg.type_   = pg::cpp::utils::MessageFormatter::ArgumentType::Double;
+                o_arg.double_ = DatumGetFloat4(a_value);
+                break;
+            case FLOAT8OID:
+                o_arg.type_   = pg::cpp::utils::MessageFormatter::ArgumentType::Double;
+                o_arg.double_ = DatumGetFloat8(a_value);
+                break;
+            case NUMERICOID:
+            {
+                // ... exact decimal digits, only NaN and infinities go as doubles ...
+                const char*  numeric = DatumGetCString(DirectFunctionCall1(numeric_out, a_value));
+                const size_t length  = strlen(numeric);
+                if ( length > 0 && isdigit(static_cast<unsigned char>(numeric[length - 1])) ) {
+                    o_arg.type_   = pg::cpp::utils::MessageFormatter::ArgumentType::Decimal;
+                    o_arg.string_ = pg::cpp::utils::StringView(numeric, length);
+                } else {
+                    o_arg.type_   = pg::cpp::utils::MessageFormatter::ArgumentType::Double;
+                    o_arg.double_ = strtod(numeric, nullptr);
+                }
+                break;
+            }
+            case DATEOID:
+            {
+                const DateADT date = DatumGetDateADT(a_value);
+                if ( DATE_NOT_FINITE(date) ) {
+                    throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_DATETIME_VALUE_OUT_OF_RANGE, "pg_cpp_utils_format_message_typed(...) - date arguments must be finite!");
+                }
+                o_arg.type_   = pg::cpp::utils::MessageFormatter::ArgumentType::Date;
+                o_arg.double_ = static_cast<double>(date) * SECS_PER_DAY * 1000.0 + k_pg_epoch_ms_;
+                break;
+            }
+            case TIMESTAMPOID:
+            case TIMESTAMPTZOID:
+            {
+                // ... timestamptz is shown as wall clock time in the session's TimeZone, as it's text output ...
+                const Timestamp timestamp = ( TIMESTAMPTZOID == a_type
+                                              ? DatumGetTimestamp(DirectFunctionCall1(timestamptz_timestamp, a_value))
+                                              : DatumGetTimestamp(a_value)
+                );
+                if ( TIMESTAMP_NOT_FINITE(timestamp) ) {
+                    throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_DATETIME_VALUE_OUT_OF_RANGE, "pg_cpp_utils_format_message_typed(...) - timestamp arguments must be finite!");
+                }
+                o_arg.type_   = pg::cpp::utils::MessageFormatter::ArgumentType::Date;
+                o_arg.double_ = static_cast<double>(timestamp) / 1000.0 + k_pg_epoch_ms_;
+                break;
+            }
+            case TEXTOID:
+            case VARCHAROID:
+                o_arg.string_ = pg_cpp_utils_text_view(DatumGetTextPP(a_value));
+                break;
+            default:
+            {
+                Oid  output_func;
+                bool is_varlena;
+                getTypeOutputInfo(a_type, &output_func, &is_varlena);
+                o_arg.string_ = pg::cpp::utils::StringView(OidOutputFunctionCall(output_func, a_value));
+                break;
+            }
+        }
+    }
+
+    /**
+     * @brief pg-cpp-utils format a message with typed ( VARIADIC "any" ) arguments.
+     */
+    PG_CPP_UTILS_FUNCTION(pg_cpp_utils_format_message_typed)
+    {
+        // ... test the number of arguments ...
+        const size_t args_count = PG_NARGS();
+        if ( args_count < 2 ) {
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_format_message_typed(...) - received %zd argument(s), expected at least %d argument(s)!", args_count, 2);
+        }
+
+        for ( size_t idx = 0 ; idx < args_count ; ++idx ) {
+            if ( 1 == PG_ARGISNULL(idx) ) {
+                throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_format_message_typed(...) - argument #%zd can not be null!", idx + 1);
+            }
+        }
+
+        // ... collect param(s) ...
+
+        const pg::cpp::utils::StringView                        locale = pg_cpp_utils_text_view(PG_GETARG_TEXT_PP(0));
+        const pg::cpp::utils::StringView                        format = pg_cpp_utils_text_view(PG_GETARG_TEXT_PP(1));
+        std::vector<pg::cpp::utils::MessageFormatter::Argument> args;
+
+        // ... output functions run while args is alive, their errors must travel as C++ exceptions ...
+        pg::cpp::utils::ErrorBridge::Call([fcinfo, args_count, &args] () {
+            if ( args_count > 2 && true == get_fn_expr_variadic(fcinfo->flinfo) ) {
+                // ... called with VARIADIC array[...] ...
+                ArrayType* in_array = PG_GETARG_ARRAYTYPE_P(2);
+                if ( ARR_NDIM(in_array) > 1 ) {
+                    throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_format_message_typed(...) - arguments array must be one-dimensional!");
+                }
+                if ( array_contains_nulls(in_array) ) {
+                    throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_format_message_typed(...) - arguments array must not contain nulls!");
+                }
+                const Oid elem_type = ARR_ELEMTYPE(in_array);
+                int16     elem_len;
+                bool      elem_by_val;
+                char      elem_align;
+                get_typlenbyvalalign(elem_type, &elem_len, &elem_by_val, &elem_align);
+                Datum* in_datums = nullptr;
+                int    in_count  = 0;
+                deconstruct_array(in_array, elem_type, elem_len, elem_by_val, elem_align, &in_datums, /* &in_nulls */ nullptr, &in_count);
+                args.resize(static_cast<size_t>(in_count));
+                for ( int idx = 0; idx < in_count; ++idx ) {
+                    pg_cpp_utils_message_argument(elem_type, in_datums[idx], args[static_cast<size_t>(idx)]);
+                }
+            } else {
+                args.resize(args_count - 2);
+                for ( size_t idx = 2 ; idx < args_count ; ++idx ) {
+                    pg_cpp_utils_message_argument(get_fn_expr_argtype(fcinfo->flinfo, static_cast<int>(idx)), PG_GETARG_DATUM(idx), args[idx - 2]);
+                }
+            }
+        });
+
+        // ... perform request ...
+        return pg_cpp_utils_utils_common<pg::cpp::utils::MessageFormatter>(fcinfo,
+                                                                           pg::cpp::utils::Stats::Function::FormatMessageTyped,
+                                                                           /* allocation */
+                                                                           [&locale] (void* a_memory) -> pg::cpp::utils::MessageFormatter* {
+                                                                               UErrorCode icu_error_code = UErrorCode::U_ZERO_ERROR;
+                                                                               u_init(&icu_error_code);
+                                                                               if ( UErrorCode::U_ZERO_ERROR != icu_error_code ) {
+                                                                                   throw PG_CPP_UTILS_EXCEPTION("ICU initialization error code %d", icu_error_code);
+                                                                               }
+                                                                               return new (a_memory) pg::cpp::utils::MessageFormatter(locale);
+                                                                           },
+                                                                           /* execute */
+                                                                           [&format, &args] (pg::cpp::utils::MessageFormatter& a_utility) -> void {
+                                                                               // ... perform ...
+                                                                               a_utility.FormatTyped(format, args);
+                                                                           },
+                                                                           /* binding */
+                                                                           pg_cpp_utils_binding({ locale })
+        );
+    }
+
+    /**
+     * @brief pg-cpp-utils in-backend benchmark of an utility hot path.
+     */
+    PG_CPP_UTILS_FUNCTION(pg_cpp_utils_bench)
+    {
+        // ... test the number of arguments ...
+        const size_t args_count = PG_NARGS();
+        if ( 2 != args_count ) {
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_FEATURE_NOT_SUPPORTED, "pg_cpp_utils_bench(...) - received %zd argument(s), expected %d argument(s)!", args_count, 2);
+        }
+
+        // ... collect param(s) ...
+        text*       tmp_utility    = PG_GETARG_TEXT_PP(0);
+        const int32 tmp_iterations = PG_GETARG_INT32(1);
+
+        if ( tmp_iterations <= 0 ) {
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_INVALID_PARAMETER_VALUE, "pg_cpp_utils_bench(...) - iterations argument must be greater than zero!");
+        }
+
+        const std::string utility    = pg_cpp_utils_text_view(tmp_utility).ToString();
+        const size_t      iterations = static_cast<size_t>(tmp_iterations);
+
+        // ... perform request ...
+        return pg_cpp_utils_utils_common<pg::cpp::utils::Benchmark>(fcinfo,
+                                                                    pg::cpp::utils::Stats::Function::Bench,
+                                                                    /* allocation */
+                                                                    [] (void* a_memory) -> pg::cpp::utils::Benchmark* {
+                                                                        return new (a_memory) pg::cpp::utils::Benchmark();
+                                                                    },
+                                                                    /* execute */
+                                                                    [&utility, &iterations] (pg::cpp::utils::Benchmark& a_utility) -> void {
+                                                                        // ... perform ...
+                                                                        a_utility.Run(utility, iterations);
+                                                                    }
+        );
+    }
+
+    /**
+     * @brief pg-cpp-utils per function execution statistics.
+     */
+    PG_CPP_UTILS_FUNCTION(pg_cpp_utils_stats)
+    {
+        // ... collect param(s) ...
+        const bool shared = ( PG_NARGS() > 0 && 0 == PG_ARGISNULL(0) ) ? PG_GETARG_BOOL(0) : false;
+
+        // ... perform request ...
+        return pg_cpp_utils_utils_common<pg::cpp::utils::Stats>(fcinfo,
+                                                                pg::cpp::utils::Stats::Function::Stats,
+                                                                /* allocation */
+                                                                [] (void* a_memory) -> pg::cpp::utils::Stats* {
+                                                                    return new (a_memory) pg::cpp::utils::Stats();
+                                                                },
+                                                                /* execute */
+                                                                [&shared] (pg::cpp::utils::Stats& a_utility) -> void {
+                                                                    // ... perform ...
+                                                                    a_utility.Collect(shared);
+                                                                }
+        );
+    }
+
+    /**
+     * @brief pg-cpp-utils backend caches counters.
+     */
+    PG_CPP_UTILS_FUNCTION(pg_cpp_utils_caches)
+    {
+        // ... perform request ...
+        return pg_cpp_utils_utils_common<pg::cpp::utils::CacheStats>(fcinfo,
+                                                                     pg::cpp::utils::Stats::Function::Caches,
+                                                                     /* allocation */
+                                                                     [] (void* a_memory) -> pg::cpp::utils::CacheStats* {
+                                                                         return new (a_memory) pg::cpp::utils::CacheStats();
+                                                                     },
+                                                                     /* execute */
+                                                                     [] (pg::cpp::utils::CacheStats& a_utility) -> void {
+                                                                         // ... perform ...
+                                                                         a_utility.Collect();
+                                                                     }
         );
     }
 
+    /**
+     * @brief Release all entries of one of this backend's caches, or of all of them.
+     */
+    PG_CPP_UTILS_FUNCTION(pg_cpp_utils_cache_reset)
+    {
+        // ... collect param(s) ...
+        const pg::cpp::utils::StringView name = ( PG_NARGS() > 0 && 0 == PG_ARGISNULL(0) ) ? pg_cpp_utils_text_view(PG_GETARG_TEXT_PP(0))
+                                                                                          : pg::cpp::utils::StringView("all");
+
+        // ... perform request ...
+        size_t count = 0;
+        try {
+            count = pg::cpp::utils::Cache::Reset(name);
+        } catch (const pg::cpp::utils::Exception& a_pg_cpp_utils_exception) {
+            throw pg::cpp::utils::ErrorBridge::Error(ERRCODE_INVALID_PARAMETER_VALUE, "%s", a_pg_cpp_utils_exception.what());
+        }
+
+        PG_RETURN_INT64(static_cast<int64>(count));
+    }
+
     /**
      * @brief pg-cpp-utils version output.
      */
-    Datum pg_cpp_utils_version (PG_FUNCTION_ARGS)
+    PG_CPP_UTILS_FUNCTION(pg_cpp_utils_version)
     {
         // ... perform request ...
-        return pg_cpp_utils_utils_common(fcinfo,
-                                         /* allocation */
-                                         [] () -> pg::cpp::utils::Utility* {
-                                             return new pg::cpp::utils::Version();
-                                         },
-                                         /* execute */
-                                         [] (pg::cpp::utils::Utility* a_utility) -> void {
-                                             // ... nothing to do ...
-                                         },
-                                         /* dealloc */
-                                         [] (pg::cpp::utils::Utility* a_utility) -> pg::cpp::utils::Utility* {
-                                             delete a_utility;
-                                             return nullptr;
-                                         }
+        return pg_cpp_utils_utils_common<pg::cpp::utils::Version>(fcinfo,
+                                                                  pg::cpp::utils::Stats::Function::Version,
+                                                                  /* allocation */
+                                                                  [] (void* a_memory) -> pg::cpp::utils::Version* {
+                                                                      return new (a_memory) pg::cpp::utils::Version();
+                                                                  },
+                                                                  /* execute */
+                                                                  [] (pg::cpp::utils::Version& /* a_utility */) -> void {
+                                                                      // ... nothing to do ...
+                                                                  }
         );
 
     }
@@ -0,0 +1,214 @@
+/**
+ * @file allocator.cc
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "pg/cpp/utils/allocator.h"
+
+extern "C" {
+    #include "utils/memutils.h" // AllocSetContextCreate
+}
+
+#include <unicode/uclean.h> // u_setMemoryFunctions
+
+#include <stdlib.h> // malloc, realloc, free
+#include <string.h> // memcpy
+
+#include <algorithm> // std::min
+
+MemoryContext                                  pg::cpp::utils::Allocator::s_context_[static_cast<size_t>(pg::cpp::utils::Allocator::Library::Count)] = { nullptr, nullptr };
+pthread_t                                      pg::cpp::utils::Allocator::s_backend_thread_;
+std::atomic<pg::cpp::utils::Allocator::Chunk*> pg::cpp::utils::Allocator::s_deferred_(nullptr);
+
+/**
+ * @brief Install ICU and OpenSSL allocation hooks, must be called by the backend's thread ( _PG_init ) before either
+ *        library allocates anything - a library that already did keeps using malloc, see \link IsRouted \link.
+ */
+void pg::cpp::utils::Allocator::Startup ()
+{
+    if ( nullptr != s_context_[static_cast<size_t>(Library::ICU)] || nullptr != s_context_[static_cast<size_t>(Library::OpenSSL)] ) {
+        return;
+    }
+
+    s_backend_thread_ = pthread_self();
+
+    MemoryContext context = AllocSetContextCreate(TopMemoryContext, "pg_cpp_utils", ALLOCSET_DEFAULT_SIZES);
+
+    // ... ICU, statically linked - refused once it's heap is in use ...
+    MemoryContext icu_context    = AllocSetContextCreate(context, "pg_cpp_utils icu", ALLOCSET_DEFAULT_SIZES);
+    UErrorCode    icu_error_code = UErrorCode::U_ZERO_ERROR;
+    u_setMemoryFunctions(nullptr, ICUAlloc, ICURealloc, ICUFree, &icu_error_code);
+    if ( U_SUCCESS(icu_error_code) ) {
+        s_context_[static_cast<size_t>(Library::ICU)] = icu_context;
+    } else {
+        MemoryContextDelete(icu_context);
+    }
+
+    // ... OpenSSL, shared with the backend - refused once it allocated, e.g. for SSL connections ...
+    MemoryContext openssl_context = AllocSetContextCreate(context, "pg_cpp_utils openssl", ALLOCSET_DEFAULT_SIZES);
+    if ( 1 == CRYPTO_set_mem_functions(OpenSSLAlloc, OpenSSLRealloc, OpenSSLFree) ) {
+        s_context_[static_cast<size_t>(Library::OpenSSL)] = openssl_context;
+    } else {
+        MemoryContextDelete(openssl_context);
+    }
+}
+
+/**
+ * @brief Allocate from \p a_library memory context or, off the backend's thread, from the heap.
+ *
+ * @param a_library
+ * @param a_size
+ *
+ * @return Allocated memory, nullptr if out of memory - never raises a postgres error.
+ */
+void* pg::cpp::utils::Allocator::Alloc (const pg::cpp::utils::Allocator::Library a_library, const size_t a_size)
+{
+    Chunk* chunk = nullptr;
+    Owner  owner = Owner::Heap;
+
+    if ( 0 != pthread_equal(pthread_self(), s_backend_thread_) ) {
+        ReleaseDeferred();
+        chunk = static_cast<Chunk*>(MemoryContextAllocExtended(s_context_[static_cast<size_t>(a_library)], sizeof(Chunk) + a_size,
+                                                               MCXT_ALLOC_HUGE | MCXT_ALLOC_NO_OOM));
+        owner = Owner::Context;
+    } else {
+        chunk = static_cast<Chunk*>(malloc(sizeof(Chunk) + a_size));
+    }
+
+    if ( nullptr == chunk ) {
+        return nullptr;
+    }
+    chunk->size_  = a_size;
+    chunk->owner_ = owner;
+
+    return chunk + 1;
+}
+
+/**
+ * @brief Resize memory obtained from \link Alloc \link, as realloc(3) does.
+ *
+ * @param a_library
+ * @param a_pointer
+ * @param a_size
+ *
+ * @return Reallocated memory, nullptr if out of memory - \p a_pointer is left untouched.
+ */
+void* pg::cpp::utils::Allocator::Realloc (const pg::cpp::utils::Allocator::Library a_library, void* a_pointer, const size_t a_size)
+{
+    if ( nullptr == a_pointer ) {
+        return Alloc(a_library, a_size);
+    }
+
+    Chunk* chunk = static_cast<Chunk*>(a_pointer) - 1;
+    if ( Owner::Heap == chunk->owner_ && 0 == pthread_equal(pthread_self(), s_backend_thread_) ) {
+        chunk = static_cast<Chunk*>(realloc(chunk, sizeof(Chunk) + a_size));
+        if ( nullptr == chunk ) {
+            return nullptr;
+        }
+        chunk->size_ = a_size;
+        return chunk + 1;
+    }
+
+    void* rv = Alloc(a_library, a_size);
+    if ( nullptr == rv ) {
+        return nullptr;
+    }
+    memcpy(rv, a_pointer, std::min(chunk->size_, a_size));
+    Free(a_pointer);
+
+    return rv;
+}
+
+/**
+ * @brief Release memory obtained from \link Alloc \link, context memory released off the backend's thread is queued.
+ *
+ * @param a_pointer
+ */
+void pg::cpp::utils::Allocator::Free (void* a_pointer)
+{
+    if ( nullptr == a_pointer ) {
+        return;
+    }
+
+    Chunk* chunk = static_cast<Chunk*>(a_pointer) - 1;
+    if ( Owner::Heap == chunk->owner_ ) {
+        free(chunk);
+    } else if ( 0 != pthread_equal(pthread_self(), s_backend_thread_) ) {
+        pfree(chunk);
+    } else {
+        // ... pfree is not thread safe ...
+        chunk->next_ = s_deferred_.load(std::memory_order_relaxed);
+        while ( false == s_deferred_.compare_exchange_weak(chunk->next_, chunk, std::memory_order_release, std::memory_order_relaxed) ) {
+            /* chunk->next_ was refreshed, retry */
+        }
+    }
+}
+
+/**
+ * @brief Release context memory queued by other threads, called by the backend's thread only.
+ */
+void pg::cpp::utils::Allocator::ReleaseDeferred ()
+{
+    if ( nullptr == s_deferred_.load(std::memory_order_relaxed) ) {
+        return;
+    }
+    Chunk* chunk = s_deferred_.exchange(nullptr, std::memory_order_acquire);
+    while ( nullptr != chunk ) {
+        Chunk* next = chunk->next_;
+        pfree(chunk);
+        chunk = next;
+    }
+}
+
+/*
+ * ICU hooks, see u_setMemoryFunctions.
+ */
+
+void* pg::cpp::utils::Allocator::ICUAlloc (const void* /* a_context */, size_t a_size)
+{
+    return Alloc(Library::ICU, a_size);
+}
+
+void* pg::cpp::utils::Allocator::ICURealloc (const void* /* a_context */, void* a_pointer, size_t a_size)
+{
+    return Realloc(Library::ICU, a_pointer, a_size);
+}
+
+void pg::cpp::utils::Allocator::ICUFree (const void* /* a_context */, void* a_pointer)
+{
+    Free(a_pointer);
+}
+
+/*
+ * OpenSSL hooks, see CRYPTO_set_mem_functions - 1.1 signatures, 1.1.1 is required ( see signer.cc ).
+ */
+
+void* pg::cpp::utils::Allocator::OpenSSLAlloc (size_t a_size, const char* /* a_file */, int /* a_line */)
+{
+    return Alloc(Library::OpenSSL, a_size);
+}
+
+void* pg::cpp::utils::Allocator::OpenSSLRealloc (void* a_pointer, size_t a_size, const char* /* a_file */, int /* a_line */)
+{
+    return Realloc(Library::OpenSSL, a_pointer, a_size);
+}
+
+void pg::cpp::utils::Allocator::OpenSSLFree (void* a_pointer, const char* /* a_file */, int /* a_line */)
+{
+    Free(a_pointer);
+}
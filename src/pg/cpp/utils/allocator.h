@@ -0,0 +1,129 @@
+/**
+ * @file allocator.h
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#ifndef PG_CPP_UTILS_ALLOCATOR_H_
+#define PG_CPP_UTILS_ALLOCATOR_H_
+
+#include "pg/postgres.h"
+
+#include <openssl/crypto.h> // CRYPTO_set_mem_functions
+
+#include <stdint.h>  // uint8_t
+#include <stddef.h>  // size_t
+#include <pthread.h> // pthread_t
+
+#include <atomic> // std::atomic
+
+namespace pg
+{
+
+    namespace cpp
+    {
+
+        namespace utils
+        {
+
+            /**
+             * @brief ICU and OpenSSL allocation hooks, backed by long-lived memory contexts ( children of a "pg_cpp_utils"
+             *        context ) so their memory is accounted for by postgres and shows up in pg_log_backend_memory_contexts.
+             *
+             * @remarks The contexts are never reset: both libraries keep caches and free memory whenever they see fit.
+             *          Allocations made off the backend's thread, e.g. by signing workers, are served by malloc; context
+             *          memory freed off the backend's thread is queued and released by the backend's thread.
+             */
+            class Allocator final
+            {
+
+            public: // Data Type(s)
+
+                enum class Library : uint8_t
+                {
+                    ICU = 0,
+                    OpenSSL,
+                    Count
+                };
+
+            private: // Data Type(s)
+
+                enum class Owner : uint32_t
+                {
+                    Context = 0,
+                    Heap
+                };
+
+                /**
+                 * @brief Header preceding every allocation, keeps user memory MAXALIGN'ed.
+                 */
+                typedef struct Chunk {
+                    union {
+                        size_t        size_;
+                        struct Chunk* next_;  // once queued for release by the backend's thread
+                    };
+                    Owner             owner_;
+                    uint32_t          padding_;
+                } Chunk;
+
+                static_assert(16 == sizeof(Chunk), "Allocator chunk header must keep user memory MAXALIGN'ed!");
+
+            private: // Static Data
+
+                static MemoryContext       s_context_[static_cast<size_t>(Library::Count)];
+                static pthread_t           s_backend_thread_;
+                static std::atomic<Chunk*> s_deferred_;
+
+            public: // Static Method(s) / Function(s)
+
+                static void Startup   ();
+                static bool IsRouted  (const Library a_library);
+
+            private: // Static Method(s) / Function(s)
+
+                static void* Alloc           (const Library a_library, const size_t a_size);
+                static void* Realloc         (const Library a_library, void* a_pointer, const size_t a_size);
+                static void  Free            (void* a_pointer);
+                static void  ReleaseDeferred ();
+
+            private: // ICU / OpenSSL Hook(s)
+
+                static void* ICUAlloc       (const void* a_context, size_t a_size);
+                static void* ICURealloc     (const void* a_context, void* a_pointer, size_t a_size);
+                static void  ICUFree        (const void* a_context, void* a_pointer);
+                static void* OpenSSLAlloc   (size_t a_size, const char* a_file, int a_line);
+                static void* OpenSSLRealloc (void* a_pointer, size_t a_size, const char* a_file, int a_line);
+                static void  OpenSSLFree    (void* a_pointer, const char* a_file, int a_line);
+
+            }; // end of class 'Allocator'
+
+            /**
+             * @return True if \p a_library allocates from it's memory context.
+             */
+            inline bool Allocator::IsRouted (const Allocator::Library a_library)
+            {
+                return nullptr != s_context_[static_cast<size_t>(a_library)];
+            }
+
+        } // end of namespace 'utils'
+
+    } // end of namespace 'cpp'
+
+} // end of namespace 'pg'
+
+#endif // PG_CPP_UTILS_ALLOCATOR_H_
@@ -0,0 +1,607 @@
+/**
+ * @file benchmark.cc
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pg/cpp/utils/benchmark.h"
+
+#include "pg/cpp/utils/exception.h"
+#include "pg/cpp/utils/error_bridge.h"
+#include "pg/cpp/utils/b64.h"
+#include "pg/cpp/utils/invoice_hash.h"
+#include "pg/cpp/utils/signature.h"
+#include "pg/cpp/utils/public_link.h"
+#include "pg/cpp/utils/number_spellout.h"
+#include "pg/cpp/utils/number_formatter.h"
+#include "pg/cpp/utils/message_formatter.h"
+
+extern "C" {
+    #include "utils/memutils.h"
+}
+
+#include <openssl/pem.h>
+#include <openssl/rsa.h> // EVP_PKEY_CTX_set_rsa_keygen_bits
+
+#include <unicode/uclean.h> // u_init
+
+#include <chrono>    // std::chrono
+#include <algorithm> // std::nth_element
+#include <memory>    // std::unique_ptr
+
+#include <stdlib.h>       // mkstemp
+#include <unistd.h>       // unlink, close, sysconf
+#include <string.h>       // strerror
+#include <inttypes.h>     // PRIu64
+#include <stdio.h>        // fopen, fscanf
+#include <sys/resource.h> // getrusage
+
+/**
+ * @brief Run a call that must fail the way a function body guarded by \link pg::cpp::utils::ErrorBridge::Guard \link does,
+ *        the postgres error it raises is caught and discarded - anything it leaks shows up as resident set growth.
+ *
+ * @param a_func void ().
+ *
+ * @throw
+ */
+template <typename Func>
+static void pg_cpp_utils_benchmark_raise (Func&& a_func)
+{
+    MemoryContext context = CurrentMemoryContext;
+    bool          raised  = false;
+
+    PG_TRY();
+    {
+        (void)pg::cpp::utils::ErrorBridge::Guard([&a_func] () -> Datum {
+            a_func();
+            return (Datum) 0;
+        });
+    }
+    PG_CATCH();
+    {
+        // ... only errors raised by the scenario itself are caught here, no resources to release ...
+        MemoryContextSwitchTo(context);
+        FlushErrorState();
+        raised = true;
+    }
+    PG_END_TRY();
+
+    if ( false == raised ) {
+        throw PG_CPP_UTILS_EXCEPTION_NA("An error was expected!");
+    }
+}
+
+/**
+ * @brief Default constructor.
+ *
+ * @param a_probe Optional heap allocation counters reader.
+ */
+pg::cpp::utils::Benchmark::Benchmark (const pg::cpp::utils::Benchmark::AllocationProbe& a_probe)
+    : probe_(a_probe)
+{
+    //
+    // B64
+    //
+    for ( auto size : { 128, 256, 4096 } ) {
+        scenarios_.push_back({ "b64", std::to_string(size) + " bytes", false, [size] (FuncCallContext*) {
+            std::vector<unsigned char> payload(static_cast<size_t>(size), 0xA5);
+            pg::cpp::utils::B64 b64;
+            if ( nullptr == b64.Encode(payload.data(), static_cast<unsigned int>(payload.size())) ) {
+                throw PG_CPP_UTILS_EXCEPTION_NA("B64 encoding failed!");
+            }
+        }});
+    }
+
+    //
+    // INVOICE HASH
+    //
+    for ( auto payload : {
+        std::string("2010-05-18;2010-05-18T11:22:19;FAC 001/14;3.12;"),
+        std::string("2010-05-18;2010-05-18T11:22:19;FAC 001/15;3.12;")
+            + std::string("mYJEv4iGwLcnQbRD7dPs2uD1mX08XjXIKcGg3GEHmwMhmmGYusffIJjTdSITLX+uujTwzqmL/U5nvt6S9s8ijN3LwkJXsiEpt099e1MET/J8y3+Y1bN+K+YPJQiVmlQS0fXETsOPo8SwUZdBALt0vTo1VhUZKejACcjEYJ9G09I=")
+    } ) {
+        scenarios_.push_back({ "invoice_hash", std::to_string(payload.length()) + " bytes payload", false, [this, payload] (FuncCallContext* a_context) {
+            pg::cpp::utils::InvoiceHash utility(pem_uri_);
+            utility.Calculate(payload);
+            Output(utility, a_context);
+        }});
+        scenarios_.push_back({ "invoice_hash", std::to_string(payload.length()) + " bytes payload, PEM key material", false, [this, payload] (FuncCallContext* a_context) {
+            pg::cpp::utils::InvoiceHash utility(pem_, pg::cpp::utils::KeyCache::Source::Memory);
+            utility.Calculate(payload);
+            Output(utility, a_context);
+        }});
+    }
+
+    //
+    // SIGN
+    //
+    for ( auto algorithm : { pg::cpp::utils::Signer::Algorithm::RSA_SHA1, pg::cpp::utils::Signer::Algorithm::RSA_PSS_SHA256, pg::cpp::utils::Signer::Algorithm::Ed25519 } ) {
+        const std::string payload = "2010-05-18;2010-05-18T11:22:19;FAC 001/14;3.12;";
+        scenarios_.push_back({ "sign", std::string(pg::cpp::utils::Signer::Name(algorithm)) + ", PEM key material", false, [this, payload, algorithm] (FuncCallContext* a_context) {
+            pg::cpp::utils::Signature utility(pg::cpp::utils::Signer::Algorithm::Ed25519 == algorithm ? ed25519_pem_ : pem_,
+                                              pg::cpp::utils::KeyCache::Source::Memory, algorithm);
+            utility.Sign(payload);
+            Output(utility, a_context);
+        }});
+    }
+
+    //
+    // PUBLIC LINK
+    //
+    scenarios_.push_back({ "public_link", "document", false, [] (FuncCallContext* a_context) {
+        pg::cpp::utils::PublicLink utility("MDEyMzQ1Njc4OWFiY2RlZjAxMjM0NTY3ODlhYmNkZWY=", "MDEyMzQ1Njc4OWFiY2RlZg==");
+        utility.Calculate("https://app.example.com/public", 1234, "document", 5678901);
+        Output(utility, a_context);
+    }});
+
+    //
+    // NUMBER SPELLOUT
+    //
+    for ( auto number : {
+        std::make_pair(std::string("7")         , 7.0),
+        std::make_pair(std::string("1234567")   , 1234567.0),
+        std::make_pair(std::string("1234567.89"), 1234567.89)
+    } ) {
+        scenarios_.push_back({ "number_spellout", "pt_PT " + number.first, true, [number] (FuncCallContext* a_context) {
+            pg::cpp::utils::NumberSpellout utility("pt_PT", "");
+            utility.Spellout(number.second);
+            Output(utility, a_context);
+        }});
+    }
+    scenarios_.push_back({ "number_spellout", "en_US 1234567", true, [] (FuncCallContext* a_context) {
+        pg::cpp::utils::NumberSpellout utility("en_US", "");
+        utility.Spellout(1234567);
+        Output(utility, a_context);
+    }});
+    scenarios_.push_back({ "number_spellout", "pt_PT 21 ordinal feminine", true, [] (FuncCallContext* a_context) {
+        pg::cpp::utils::NumberSpellout utility("pt_PT", "", "%spellout-ordinal-feminine");
+        utility.Spellout(21);
+        Output(utility, a_context);
+    }});
+    static const char* const k_pt_PT_override_ =
+        "%spellout-numbering:\n"
+        "0: =%spellout-cardinal-masculine=;\n"
+        "%spellout-cardinal-masculine:\n"
+        "-x: menos >>;\n"
+        "x.x: << vírgula >>;\n"
+        "0: zero; 1: um; 2: dois; 3: três; 4: quatro; 5: cinco; 6: seis; 7: sete; 8: oito; 9: nove;\n"
+        "10: dez; 11: onze; 12: doze; 13: treze; 14: catorze; 15: quinze; 16: dezasseis; 17: dezassete; 18: dezoito; 19: dezanove;\n"
+        "20: vinte[ e >>]; 30: trinta[ e >>]; 40: quarenta[ e >>]; 50: cinquenta[ e >>];\n"
+        "60: sessenta[ e >>]; 70: setenta[ e >>]; 80: oitenta[ e >>]; 90: noventa[ e >>];\n"
+        "100: cem; 101: cento e >>; 200: duzentos[ e >>]; 300: trezentos[ e >>]; 400: quatrocentos[ e >>];\n"
+        "500: quinhentos[ e >>]; 600: seiscentos[ e >>]; 700: setecentos[ e >>]; 800: oitocentos[ e >>]; 900: novecentos[ e >>];\n"
+        "1000: mil[, >>]; 2000: << mil[, >>];\n"
+        "1000000: um milhão[, >>]; 2000000: << milhões[, >>];\n"
+        "1000000000: um bilião[, >>]; 2000000000: << biliões[, >>];\n"
+        "1000000000000: =#,##0=;\n";
+    scenarios_.push_back({ "number_spellout", "pt_PT 1234567 with override", true, [] (FuncCallContext* a_context) {
+        pg::cpp::utils::NumberSpellout utility("pt_PT", k_pt_PT_override_);
+        utility.Spellout(1234567);
+        Output(utility, a_context);
+    }});
+    scenarios_.push_back({ "number_spellout", "pt_PT 1234567 with named override", true, [] (FuncCallContext* a_context) {
+        // ... registered once, as pg_cpp_utils_spellout_rules_load would ...
+        if ( false == pg::cpp::utils::SpelloutRules::IsLoaded("pg_cpp_utils.bench") ) {
+            pg::cpp::utils::SpelloutRules::Load("pg_cpp_utils.bench", { pg::cpp::utils::SpelloutRules::Definition("pt_PT", k_pt_PT_override_) });
+        }
+        pg::cpp::utils::NumberSpellout utility("pt_PT", "pg_cpp_utils.bench");
+        utility.Spellout(1234567);
+        Output(utility, a_context);
+    }});
+
+    //
+    // CURRENCY SPELLOUT
+    //
+    for ( auto amount : { std::make_pair(1.0, 0.0), std::make_pair(1234567.0, 89.0) } ) {
+        const std::string input = "pt_PT " + std::to_string(static_cast<int64_t>(amount.first)) + " / " + std::to_string(static_cast<int64_t>(amount.second));
+        scenarios_.push_back({ "currency_spellout", input, true, [amount] (FuncCallContext* a_context) {
+            pg::cpp::utils::NumberSpellout utility("pt_PT", "");
+            utility.CurrencySpellout(amount.first , "euro"   , "euros",
+                                     amount.second, "cêntimo", "cêntimos",
+                                     "{3} {0, plural, =1 {{1}} other {{2}}}{4, plural, =0 {} other { e {7} {4, plural, =1 {{5}} other {{6}}}}}"
+            );
+            Output(utility, a_context);
+        }});
+    }
+
+    //
+    // NUMBER FORMATTER
+    //
+    for ( auto args : {
+        std::make_pair(std::string("pt_PT"), std::string("#,##0.00 €")),
+        std::make_pair(std::string("en_GB"), std::string("£ #,##0.00"))
+    } ) {
+        scenarios_.push_back({ "number_formatter", args.first + " '" + args.second + "'", true, [args] (FuncCallContext* a_context) {
+            pg::cpp::utils::NumberFormatter utility(args.first);
+            utility.Format(12345.432, args.second);
+            Output(utility, a_context);
+        }});
+    }
+    scenarios_.push_back({ "number_formatter", "pt_PT '#,##0.00 €' reused by call site", true, [] (FuncCallContext* a_context) {
+        // ... as kept at fn_extra while a call site's locale doesn't change ...
+        static std::unique_ptr<pg::cpp::utils::NumberFormatter> utility(new pg::cpp::utils::NumberFormatter("pt_PT"));
+        utility->Format(12345.432, "#,##0.00 €");
+        Output(*utility, a_context);
+    }});
+
+    //
+    // MESSAGE FORMATTER
+    //
+    scenarios_.push_back({ "message_formatter", "positional", true, [] (FuncCallContext* a_context) {
+        pg::cpp::utils::MessageFormatter utility("en_US");
+        utility.Format("A={0}, B={1}, C={2}", { "a", "b", "c" });
+        Output(utility, a_context);
+    }});
+    scenarios_.push_back({ "message_formatter", "select", true, [] (FuncCallContext* a_context) {
+        pg::cpp::utils::MessageFormatter utility("pt_PT");
+        utility.Format("{0} {1, select, one {documento} other {documentos}}", { "2", "other" });
+        Output(utility, a_context);
+    }});
+    scenarios_.push_back({ "message_formatter", "typed", true, [] (FuncCallContext* a_context) {
+        pg::cpp::utils::MessageFormatter           utility("pt_PT");
+        pg::cpp::utils::MessageFormatter::Argument args[2];
+        args[0].type_   = pg::cpp::utils::MessageFormatter::ArgumentType::Int64;
+        args[0].int64_  = 2;
+        args[1].type_   = pg::cpp::utils::MessageFormatter::ArgumentType::Double;
+        args[1].double_ = 1234.5;
+        utility.FormatTyped("{0, plural, one {# documento} other {# documentos}}: {1, number, #,##0.00}", { args[0], args[1] });
+        Output(utility, a_context);
+    }});
+    scenarios_.push_back({ "message_formatter", "typed reused by call site", true, [] (FuncCallContext* a_context) {
+        // ... as kept at fn_extra while a call site's locale doesn't change ...
+        static std::unique_ptr<pg::cpp::utils::MessageFormatter> utility(new pg::cpp::utils::MessageFormatter("pt_PT"));
+        pg::cpp::utils::MessageFormatter::Argument               args[2];
+        args[0].type_   = pg::cpp::utils::MessageFormatter::ArgumentType::Int64;
+        args[0].int64_  = 2;
+        args[1].type_   = pg::cpp::utils::MessageFormatter::ArgumentType::Double;
+        args[1].double_ = 1234.5;
+        utility->FormatTyped("{0, plural, one {# documento} other {# documentos}}: {1, number, #,##0.00}", { args[0], args[1] });
+        Output(*utility, a_context);
+    }});
+
+    //
+    // ERROR BRIDGE
+    //
+    scenarios_.push_back({ "error_bridge", "utility status", true, [] (FuncCallContext* a_context) {
+        pg_cpp_utils_benchmark_raise([a_context] () {
+            pg::cpp::utils::NumberSpellout utility("pt_PT", "", "%no-such-rule-set");
+            utility.Spellout(1234567);
+            Output(utility, a_context);
+        });
+    }});
+    scenarios_.push_back({ "error_bridge", "postgres error", false, [] (FuncCallContext* /* a_context */) {
+        pg_cpp_utils_benchmark_raise([] () {
+            // ... heap state alive while postgres raises an error, e.g. palloc out of memory ...
+            const std::string                       text(256, 'x');
+            std::vector<pg::cpp::utils::StringView> views(16, pg::cpp::utils::StringView(text.c_str(), text.length()));
+            pg::cpp::utils::ErrorBridge::Call([] () {
+                ereport(ERROR, (errcode(ERRCODE_INVALID_PARAMETER_VALUE), errmsg("pg_cpp_utils_bench - raised on purpose!")));
+            });
+        });
+    }});
+}
+
+/**
+ * @brief Destructor.
+ */
+pg::cpp::utils::Benchmark::~Benchmark ()
+{
+    if ( 0 != pem_uri_.length() ) {
+        unlink(pem_uri_.c_str());
+    }
+}
+
+/**
+ * @brief Fill user provided context information, one record per measured scenario.
+ *
+ * @param a_context
+ */
+void pg::cpp::utils::Benchmark::FillOutputAtUserFuncContext (FuncCallContext* a_context)
+{
+    Utility::Records* records = Utility::UserFuncContextRecords(a_context);
+    for ( auto& result : results_ ) {
+        const double ops_per_sec = result.total_ns_ > 0 ? ( 1e9 * result.iterations_ ) / result.total_ns_ : 0.0;
+        char**       values      = records->Append(7);
+        values[0] = records->Copy(result.utility_);
+        values[1] = records->Copy(result.input_);
+        values[2] = records->Format("%f", ops_per_sec);
+        values[3] = records->Format("%" PRIu64, result.p50_ns_);
+        values[4] = records->Format("%" PRIu64, result.p99_ns_);
+        values[5] = records->Format("%" PRIu64, static_cast<uint64_t>(( result.bytes_allocated_ + result.palloc_bytes_ ) / result.iterations_));
+        values[6] = records->Format("%" PRId64, result.rss_growth_);
+        a_context->max_calls += 1;
+    }
+}
+
+/**
+ * @brief Run all scenarios of an utility.
+ *
+ * @param a_utility    Utility name, see \link Utilities \link; '*' for all.
+ * @param a_iterations Number of measured calls per scenario.
+ *
+ * @throw
+ */
+void pg::cpp::utils::Benchmark::Run (const std::string& a_utility, const size_t a_iterations)
+{
+    results_.clear();
+
+    if ( 0 == a_iterations ) {
+        throw PG_CPP_UTILS_EXCEPTION_NA("Number of iterations must be greater than zero!");
+    }
+
+    const auto& utilities = Utilities();
+    if ( "*" != a_utility && utilities.end() == std::find(utilities.begin(), utilities.end(), a_utility) ) {
+        throw PG_CPP_UTILS_EXCEPTION("Unknown utility '%s'!", a_utility.c_str());
+    }
+
+    if ( ( "*" == a_utility || "invoice_hash" == a_utility || "sign" == a_utility ) && 0 == pem_uri_.length() ) {
+        WritePrivateKey();
+    }
+
+    for ( auto& scenario : scenarios_ ) {
+        if ( "*" != a_utility && a_utility != scenario.utility_ ) {
+            continue;
+        }
+        results_.push_back(Result());
+        Measure(scenario, a_iterations, results_.back());
+    }
+}
+
+/**
+ * @return The names of all utilities that can be measured.
+ */
+const std::vector<std::string>& pg::cpp::utils::Benchmark::Utilities ()
+{
+    static const std::vector<std::string> s_utilities = {
+        "b64", "invoice_hash", "sign", "public_link", "number_spellout", "currency_spellout", "number_formatter", "message_formatter",
+        "error_bridge"
+    };
+    return s_utilities;
+}
+
+/**
+ * @brief Measure a scenario, the same way \link pg_cpp_utils_utils_common \link runs it.
+ *
+ * @param a_scenario
+ * @param a_iterations
+ * @param o_result
+ *
+ * @throw
+ */
+void pg::cpp::utils::Benchmark::Measure (const pg::cpp::utils::Benchmark::Scenario& a_scenario, const size_t a_iterations,
+                                         pg::cpp::utils::Benchmark::Result& o_result)
+{
+    const size_t          warm_up    = std::max(static_cast<size_t>(1), a_iterations / 10);
+    std::vector<uint64_t> samples(a_iterations, 0);
+    uint64_t              allocations[2] = { 0, 0 };
+    uint64_t              bytes[2]       = { 0, 0 };
+    uint64_t              palloc_bytes   = 0;
+    int64_t               rss[2]         = { 0, 0 };
+
+    MemoryContext bench_context = AllocSetContextCreate(CurrentMemoryContext, "pg_cpp_utils_bench", ALLOCSET_DEFAULT_SIZES);
+    MemoryContext old_context   = MemoryContextSwitchTo(bench_context);
+    // ... a reset keeps the context initial block, so only growth past it is accounted ...
+    const Size    keeper_bytes  = MemoryContextMemAllocated(bench_context, true);
+
+    try {
+
+        for ( size_t idx = 0 ; idx < warm_up + a_iterations ; ++idx ) {
+
+            if ( warm_up == idx ) {
+                if ( nullptr != probe_ ) {
+                    probe_(allocations[0], bytes[0]);
+                }
+                rss[0] = ResidentSetSize();
+            }
+
+            FuncCallContext func_call_context;
+            memset(&func_call_context, 0, sizeof(FuncCallContext));
+            func_call_context.multi_call_memory_ctx = bench_context;
+
+            const auto start = std::chrono::steady_clock::now();
+            if ( true == a_scenario.icu_ ) {
+                UErrorCode icu_error_code = UErrorCode::U_ZERO_ERROR;
+                u_init(&icu_error_code);
+                if ( UErrorCode::U_ZERO_ERROR != icu_error_code ) {
+                    throw PG_CPP_UTILS_EXCEPTION("ICU initialization error code %d", icu_error_code);
+                }
+            }
+            a_scenario.call_(&func_call_context);
+            const auto end = std::chrono::steady_clock::now();
+
+            if ( idx >= warm_up ) {
+                samples[idx - warm_up] = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+                palloc_bytes          += MemoryContextMemAllocated(bench_context, true) - keeper_bytes;
+            }
+
+            MemoryContextReset(bench_context);
+        }
+
+        if ( nullptr != probe_ ) {
+            probe_(allocations[1], bytes[1]);
+        }
+        rss[1] = ResidentSetSize();
+
+    } catch (...) {
+        MemoryContextSwitchTo(old_context);
+        MemoryContextDelete(bench_context);
+        throw;
+    }
+
+    MemoryContextSwitchTo(old_context);
+    MemoryContextDelete(bench_context);
+
+    o_result.utility_         = a_scenario.utility_;
+    o_result.input_           = a_scenario.input_;
+    o_result.iterations_      = a_iterations;
+    o_result.total_ns_        = 0;
+    for ( auto sample : samples ) {
+        o_result.total_ns_ += sample;
+    }
+    o_result.allocations_     = allocations[1] - allocations[0];
+    o_result.bytes_allocated_ = bytes[1] - bytes[0];
+    o_result.palloc_bytes_    = palloc_bytes;
+    o_result.rss_growth_      = rss[1] - rss[0];
+
+    std::nth_element(samples.begin(), samples.begin() + ( samples.size() / 2 ), samples.end());
+    o_result.p50_ns_ = samples[samples.size() / 2];
+    std::nth_element(samples.begin(), samples.begin() + ( ( samples.size() * 99 ) / 100 ), samples.end());
+    o_result.p99_ns_ = samples[( samples.size() * 99 ) / 100];
+}
+
+/**
+ * @brief Collect an utility output, as \link pg_cpp_utils_utils_common \link does.
+ *
+ * @param a_utility
+ * @param a_context
+ *
+ * @throw
+ */
+void pg::cpp::utils::Benchmark::Output (pg::cpp::utils::Utility& a_utility, FuncCallContext* a_context)
+{
+    const pg::cpp::utils::Status& status = a_utility.LastStatus();
+    if ( true == status.Failed() ) {
+        throw PG_CPP_UTILS_EXCEPTION("%s", status.Message().c_str());
+    }
+
+    pg::cpp::utils::Utility::AllocUserFuncContext(a_context);
+    try {
+        a_utility.FillOutputAtUserFuncContext(a_context);
+        pg::cpp::utils::Utility::Records* records = pg::cpp::utils::Utility::UserFuncContextRecords(a_context);
+        for ( uint64_t idx = 0 ; idx < a_context->max_calls ; ++idx ) {
+            if ( nullptr == records->Values(idx) ) {
+                throw PG_CPP_UTILS_EXCEPTION("missing record #%" PRIu64 "!", idx);
+            }
+        }
+    } catch (...) {
+        pg::cpp::utils::Utility::DeallocUserFuncContext(a_context);
+        throw;
+    }
+    pg::cpp::utils::Utility::DeallocUserFuncContext(a_context);
+}
+
+/**
+ * @brief Generate throwaway private keys: RSA 1024 ( as certified invoicing keys, 172 bytes B64 signatures ), stored in a temporary PEM
+ *        file and kept in memory as PEM key material, and Ed25519, kept in memory only.
+ *
+ * @throw
+ */
+void pg::cpp::utils::Benchmark::WritePrivateKey ()
+{
+    char  uri[] = "/tmp/pg-cpp-utils-bench-XXXXXX";
+    FILE* file  = nullptr;
+
+    pem_         = GeneratePrivateKey(EVP_PKEY_RSA, 1024);
+    ed25519_pem_ = GeneratePrivateKey(EVP_PKEY_ED25519, 0);
+
+    const int fd = mkstemp(uri);
+    if ( -1 == fd ) {
+        const int err = errno;
+        throw PG_CPP_UTILS_EXCEPTION("Unable to create temporary file '%s' : %s!", uri, strerror(err));
+    }
+
+    file = fdopen(fd, "w");
+    if ( nullptr == file ) {
+        close(fd);
+        unlink(uri);
+        throw PG_CPP_UTILS_EXCEPTION("Unable to open temporary file '%s'!", uri);
+    }
+
+    if ( pem_.length() != fwrite(pem_.c_str(), sizeof(char), pem_.length(), file) ) {
+        fclose(file);
+        unlink(uri);
+        throw PG_CPP_UTILS_EXCEPTION("Unable to write temporary file '%s'!", uri);
+    }
+    fclose(file);
+
+    pem_uri_ = uri;
+}
+
+/**
+ * @brief Generate a throwaway private key.
+ *
+ * @param a_id   EVP_PKEY_RSA or EVP_PKEY_ED25519.
+ * @param a_bits RSA modulus size.
+ *
+ * @return PEM key material.
+ *
+ * @throw
+ */
+std::string pg::cpp::utils::Benchmark::GeneratePrivateKey (const int a_id, const int a_bits)
+{
+    EVP_PKEY_CTX* ctx  = EVP_PKEY_CTX_new_id(a_id, NULL);
+    EVP_PKEY*     pkey = nullptr;
+    BIO*          bio  = BIO_new(BIO_s_mem());
+
+    const auto cleanup = [&ctx, &pkey, &bio] () {
+        if ( nullptr != bio ) {
+            BIO_free(bio);
+        }
+        if ( nullptr != pkey ) {
+            EVP_PKEY_free(pkey);
+        }
+        if ( nullptr != ctx ) {
+            EVP_PKEY_CTX_free(ctx);
+        }
+    };
+
+    if ( nullptr == ctx || nullptr == bio || 1 != EVP_PKEY_keygen_init(ctx)
+        || ( EVP_PKEY_RSA == a_id && 1 != EVP_PKEY_CTX_set_rsa_keygen_bits(ctx, a_bits) )
+        || 1 != EVP_PKEY_keygen(ctx, &pkey)
+        || 1 != PEM_write_bio_PrivateKey(bio, pkey, NULL, NULL, 0, NULL, NULL) ) {
+        cleanup();
+        throw PG_CPP_UTILS_EXCEPTION_NA("Error while generating private key!");
+    }
+
+    char*             data   = nullptr;
+    const long        length = BIO_get_mem_data(bio, &data);
+    const std::string pem    = std::string(data, static_cast<size_t>(length));
+
+    cleanup();
+
+    return pem;
+}
+
+/**
+ * @return This process resident set size, in bytes - peak resident set size where the current one can't be read.
+ */
+int64_t pg::cpp::utils::Benchmark::ResidentSetSize ()
+{
+#if defined(__linux__)
+    long  size     = 0;
+    long  resident = 0;
+    FILE* file     = fopen("/proc/self/statm", "r");
+    if ( nullptr != file ) {
+        if ( 2 != fscanf(file, "%ld %ld", &size, &resident) ) {
+            resident = 0;
+        }
+        fclose(file);
+    }
+    return static_cast<int64_t>(resident) * static_cast<int64_t>(sysconf(_SC_PAGESIZE));
+#else
+    struct rusage usage;
+    if ( 0 != getrusage(RUSAGE_SELF, &usage) ) {
+        return 0;
+    }
+    #if defined(__APPLE__)
+        return static_cast<int64_t>(usage.ru_maxrss);        // bytes
+    #else
+        return static_cast<int64_t>(usage.ru_maxrss) * 1024; // kilobytes
+    #endif
+#endif
+}
@@ -0,0 +1,124 @@
+/**
+ * @file benchmark.h
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef PG_CPP_UTILS_BENCHMARK_H_
+#define PG_CPP_UTILS_BENCHMARK_H_
+
+#include "pg/cpp/utils/utility.h"
+
+#include <string>     // std::string
+#include <vector>     // std::vector
+#include <functional> // std::function
+
+namespace pg
+{
+
+    namespace cpp
+    {
+
+        namespace utils
+        {
+
+            class Benchmark final : public Utility
+            {
+
+            public: // Data Type(s)
+
+                typedef struct {
+                    std::string utility_;
+                    std::string input_;
+                    size_t      iterations_;
+                    uint64_t    total_ns_;
+                    uint64_t    p50_ns_;
+                    uint64_t    p99_ns_;
+                    uint64_t    allocations_;
+                    uint64_t    bytes_allocated_;
+                    uint64_t    palloc_bytes_;
+                    int64_t     rss_growth_;      // resident set size growth, from warm up to the last call
+                } Result;
+
+                /**
+                 * @brief Reads monotonic heap allocation counters ( calls and bytes ), sampled before and after each run; optional.
+                 */
+                typedef std::function<void(uint64_t& o_allocations, uint64_t& o_bytes)> AllocationProbe;
+
+            private: // Data Type(s)
+
+                typedef struct {
+                    std::string                           utility_;
+                    std::string                           input_;
+                    bool                                  icu_;
+                    std::function<void(FuncCallContext*)> call_;
+                } Scenario;
+
+            private: // Data
+
+                const AllocationProbe probe_;
+                std::string           pem_uri_;
+                std::string           pem_;
+                std::string           ed25519_pem_;
+                std::vector<Scenario> scenarios_;
+                std::vector<Result>   results_;
+
+            public: // Constructor / Destructor.
+
+                Benchmark (const AllocationProbe& a_probe = nullptr);
+                virtual ~Benchmark();
+
+            public: // Inherited Pure Virtual Method(s) / Function(s)
+
+                virtual void FillOutputAtUserFuncContext (FuncCallContext* a_context);
+
+            public: // Method(s) / Function(s)
+
+                void                       Run     (const std::string& a_utility, const size_t a_iterations);
+                const std::vector<Result>& Results () const;
+
+            public: // Static Method(s) / Function(s)
+
+                static const std::vector<std::string>& Utilities ();
+
+            private: // Method(s) / Function(s)
+
+                void Measure          (const Scenario& a_scenario, const size_t a_iterations, Result& o_result);
+                void WritePrivateKey  ();
+
+            private: // Static Method(s) / Function(s)
+
+                static void        Output             (Utility& a_utility, FuncCallContext* a_context);
+                static std::string GeneratePrivateKey (const int a_id, const int a_bits);
+                static int64_t     ResidentSetSize    ();
+
+            }; // end of class 'Benchmark'
+
+            inline const std::vector<Benchmark::Result>& Benchmark::Results () const
+            {
+                return results_;
+            }
+
+        } // end of namespace 'utils'
+
+    } // end of namespace 'cpp'
+
+} // end of namespace 'pg'
+
+#endif // PG_CPP_UTILS_BENCHMARK_H_
@@ -0,0 +1,195 @@
+/**
+ * @file cache.cc
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pg/cpp/utils/cache.h"
+
+#include "pg/cpp/utils/exception.h"
+#include "pg/cpp/utils/stats.h"
+
+#include <string.h> // memset
+
+#include <string> // std::string
+
+// ... constant initialized, caches register themselves while other translation units are being initialized ...
+pg::cpp::utils::Cache* pg::cpp::utils::Cache::s_head_   = nullptr;
+size_t                 pg::cpp::utils::Cache::s_budget_ = 16 * 1024 * 1024;
+size_t                 pg::cpp::utils::Cache::s_bytes_  = 0;
+uint64_t               pg::cpp::utils::Cache::s_tick_   = 0;
+
+/**
+ * @brief Default constructor, registers this cache.
+ *
+ * @param a_name See \link Name \link, must be a literal.
+ */
+pg::cpp::utils::Cache::Cache (const char* const a_name)
+    : name_(a_name), next_(s_head_)
+{
+    memset(&counters_, 0, sizeof(counters_));
+    s_head_ = this;
+}
+
+/**
+ * @brief Destructor, unregisters this cache.
+ */
+pg::cpp::utils::Cache::~Cache ()
+{
+    for ( Cache** it = &s_head_ ; nullptr != *it ; it = &(*it)->next_ ) {
+        if ( this == *it ) {
+            *it = next_;
+            break;
+        }
+    }
+}
+
+/**
+ * @return A new tick, entries keep the one of their last use.
+ */
+uint64_t pg::cpp::utils::Cache::Touch ()
+{
+    return ++s_tick_;
+}
+
+/**
+ * @brief Account for a lookup that found it's entry, also reported per function by \link Stats \link.
+ */
+void pg::cpp::utils::Cache::Hit ()
+{
+    counters_.hits_ += 1;
+    pg::cpp::utils::Stats::CacheHit();
+}
+
+/**
+ * @brief Account for a lookup that did not find it's entry, also reported per function by \link Stats \link.
+ */
+void pg::cpp::utils::Cache::Miss ()
+{
+    counters_.misses_ += 1;
+    pg::cpp::utils::Stats::CacheMiss();
+}
+
+/**
+ * @brief Account for a new entry, evicting least recently used ones while over budget.
+ *
+ * @param a_bytes Entry's estimated size.
+ */
+void pg::cpp::utils::Cache::Added (const size_t a_bytes)
+{
+    counters_.entries_ += 1;
+    counters_.bytes_   += a_bytes;
+    s_bytes_           += a_bytes;
+    Enforce();
+}
+
+/**
+ * @brief Account for a released entry.
+ *
+ * @param a_bytes   Entry's estimated size, as \link Added \link.
+ * @param a_evicted True when released to honor a limit rather than by request.
+ */
+void pg::cpp::utils::Cache::Removed (const size_t a_bytes, const bool a_evicted)
+{
+    counters_.entries_ -= 1;
+    counters_.bytes_   -= a_bytes;
+    s_bytes_           -= a_bytes;
+    if ( true == a_evicted ) {
+        counters_.evictions_ += 1;
+    }
+}
+
+/**
+ * @brief Change the memory budget shared by all caches, see pg_cpp_utils.cache_size.
+ *
+ * @param a_bytes
+ */
+void pg::cpp::utils::Cache::Budget (const size_t a_bytes)
+{
+    s_budget_ = a_bytes;
+    Enforce();
+}
+
+/**
+ * @brief Release all entries of a cache, or of all caches.
+ *
+ * @param a_name \link Name \link of a cache, 'all' for every one of them.
+ *
+ * @return Number of entries released.
+ *
+ * @throw When \p a_name is not a cache's name.
+ */
+size_t pg::cpp::utils::Cache::Reset (const pg::cpp::utils::StringView& a_name)
+{
+    const bool all   = a_name.Equals(StringView("all"));
+    size_t     count = 0;
+    bool       found = all;
+
+    for ( Cache* cache = s_head_ ; nullptr != cache ; cache = cache->next_ ) {
+        if ( true == all || true == a_name.Equals(StringView(cache->name_)) ) {
+            count += cache->Clear();
+            found  = true;
+        }
+    }
+
+    if ( false == found ) {
+        std::string available;
+        for ( const Cache* cache = s_head_ ; nullptr != cache ; cache = cache->next_ ) {
+            available += cache->name_;
+            available += ", ";
+        }
+        available += "all";
+        throw PG_CPP_UTILS_EXCEPTION("Unknown cache '%.*s', available: %s",
+                                     static_cast<int>(a_name.Length()), a_name.Data(), available.c_str());
+    }
+
+    return count;
+}
+
+/**
+ * @return First registered cache, nullptr if none.
+ */
+const pg::cpp::utils::Cache* pg::cpp::utils::Cache::First ()
+{
+    return s_head_;
+}
+
+/**
+ * @brief Evict least recently used entries, of whatever cache, until all caches fit the budget.
+ *
+ * @remarks The most recently used entry is always kept, so a value just inserted is valid even if it alone
+ *          exceeds the budget.
+ */
+void pg::cpp::utils::Cache::Enforce ()
+{
+    while ( s_bytes_ > s_budget_ ) {
+        Cache*   victim = nullptr;
+        uint64_t oldest = 0;
+        for ( Cache* cache = s_head_ ; nullptr != cache ; cache = cache->next_ ) {
+            const uint64_t tick = cache->Oldest();
+            if ( 0 != tick && ( nullptr == victim || tick < oldest ) ) {
+                victim = cache;
+                oldest = tick;
+            }
+        }
+        if ( nullptr == victim || s_tick_ == oldest ) {
+            break;
+        }
+        victim->EvictOldest();
+    }
+}
@@ -0,0 +1,389 @@
+/**
+ * @file cache.h
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef PG_CPP_UTILS_CACHE_H_
+#define PG_CPP_UTILS_CACHE_H_
+
+#include "pg/cpp/utils/string_view.h"
+
+#include <stdint.h> // uint64_t
+#include <stddef.h> // size_t
+
+#include <list>          // std::list
+#include <unordered_map> // std::unordered_map
+#include <functional>    // std::hash
+#include <iterator>      // std::prev
+#include <utility>       // std::move
+
+namespace pg
+{
+
+    namespace cpp
+    {
+
+        namespace utils
+        {
+
+            /**
+             * @brief Backend wide cache, one of a registry sharing a single memory budget ( pg_cpp_utils.cache_size ).
+             *
+             * @remarks Once the budget is exceeded the least recently used entry of all caches is evicted, whatever cache
+             *          it belongs to. Sizes are estimates of what an entry holds, see \link LRUCache::Insert \link.
+             */
+            class Cache
+            {
+
+            public: // Data Type(s)
+
+                typedef struct {
+                    uint64_t hits_;
+                    uint64_t misses_;
+                    uint64_t evictions_;
+                    uint64_t entries_;
+                    uint64_t bytes_;
+                } Counters;
+
+                /**
+                 * @brief Default entry release hook, does nothing.
+                 */
+                struct Keep
+                {
+                    template <typename K, typename V> void operator() (const K&, V&) const { /* empty */ }
+                };
+
+            private: // Static Data
+
+                static Cache*   s_head_;
+                static size_t   s_budget_;
+                static size_t   s_bytes_;
+                static uint64_t s_tick_;
+
+            private: // Data
+
+                const char* const name_;
+                Cache*            next_;
+
+            protected: // Data
+
+                Counters counters_;
+
+            public: // Constructor / Destructor.
+
+                Cache (const char* const a_name);
+                virtual ~Cache();
+
+                Cache (const Cache&) = delete;
+                Cache& operator= (const Cache&) = delete;
+
+            public: // Pure Virtual Method(s) / Function(s)
+
+                virtual size_t Clear () = 0;
+
+            protected: // Pure Virtual Method(s) / Function(s)
+
+                virtual uint64_t Oldest      () const = 0;
+                virtual void     EvictOldest () = 0;
+
+            public: // Method(s) / Function(s)
+
+                inline const char*     Name  () const;
+                inline const Counters& Usage () const;
+                inline const Cache*    Next  () const;
+
+            protected: // Method(s) / Function(s)
+
+                uint64_t Touch   ();
+                void     Hit     ();
+                void     Miss    ();
+                void     Added   (const size_t a_bytes);
+                void     Removed (const size_t a_bytes, const bool a_evicted);
+
+            public: // Static Method(s) / Function(s)
+
+                static void         Budget (const size_t a_bytes);
+                static size_t       Reset  (const StringView& a_name);
+                static const Cache* First  ();
+
+            private: // Static Method(s) / Function(s)
+
+                static void Enforce ();
+
+            }; // end of class 'Cache'
+
+            /**
+             * @return Name, as known to pg_cpp_utils_cache_reset.
+             */
+            inline const char* Cache::Name () const
+            {
+                return name_;
+            }
+
+            /**
+             * @return This cache's counters.
+             */
+            inline const Cache::Counters& Cache::Usage () const
+            {
+                return counters_;
+            }
+
+            /**
+             * @return Next registered cache, nullptr if none.
+             */
+            inline const Cache* Cache::Next () const
+            {
+                return next_;
+            }
+
+            /**
+             * @brief Least recently used cache, keyed by \p K.
+             *
+             * @remarks \p R is called ( key, value ) whenever an entry leaves the cache, except when the cache itself is
+             *          destroyed - at process exit.
+             */
+            template <typename K, typename V, typename H = std::hash<K>, typename R = Cache::Keep>
+            class LRUCache final : public Cache
+            {
+
+            private: // Data Type(s)
+
+                struct Entry
+                {
+                    K        key_;
+                    V        value_;
+                    size_t   bytes_;
+                    uint64_t tick_;
+
+                    Entry (const K& a_key, V&& a_value, const size_t a_bytes, const uint64_t a_tick)
+                        : key_(a_key), value_(std::move(a_value)), bytes_(a_bytes), tick_(a_tick)
+                    {
+                        /* empty */
+                    }
+                };
+
+                typedef std::list<Entry> Entries; // most recently used first
+
+                /**
+                 * @brief Estimated bookkeeping cost of an entry, list node and index node.
+                 */
+                static constexpr size_t k_overhead_ = sizeof(Entry) + 2 * sizeof(void*) + sizeof(K) + 3 * sizeof(void*);
+
+            private: // Data
+
+                Entries                                              entries_;
+                std::unordered_map<K, typename Entries::iterator, H> index_;
+                size_t                                               limit_; // entries
+
+            public: // Constructor / Destructor.
+
+                /**
+                 * @brief Default constructor.
+                 *
+                 * @param a_name  See \link Cache::Name \link.
+                 * @param a_limit Maximum number of entries, besides the memory budget.
+                 */
+                LRUCache (const char* const a_name, const size_t a_limit = SIZE_MAX)
+                    : Cache(a_name), limit_(a_limit)
+                {
+                    /* empty */
+                }
+
+                /**
+                 * @brief Destructor.
+                 */
+                virtual ~LRUCache ()
+                {
+                    for ( auto& entry : entries_ ) {
+                        Removed(entry.bytes_, /* a_evicted */ false);
+                    }
+                }
+
+            public: // Inherited Pure Virtual Method(s) / Function(s)
+
+                /**
+                 * @brief Release all entries.
+                 *
+                 * @return Number of entries released.
+                 */
+                virtual size_t Clear ()
+                {
+                    const size_t count = entries_.size();
+                    while ( false == entries_.empty() ) {
+                        Drop(std::prev(entries_.end()), /* a_evicted */ false);
+                    }
+                    return count;
+                }
+
+            protected: // Inherited Pure Virtual Method(s) / Function(s)
+
+                /**
+                 * @return Least recently used entry's tick, 0 if empty.
+                 */
+                virtual uint64_t Oldest () const
+                {
+                    return true == entries_.empty() ? 0 : entries_.back().tick_;
+                }
+
+                /**
+                 * @brief Evict the least recently used entry.
+                 */
+                virtual void EvictOldest ()
+                {
+                    if ( false == entries_.empty() ) {
+                        Drop(std::prev(entries_.end()), /* a_evicted */ true);
+                    }
+                }
+
+            public: // Method(s) / Function(s)
+
+                /**
+                 * @brief Look up an entry, marking it as the most recently used one.
+                 *
+                 * @param a_key
+                 *
+                 * @return Value owned by the cache, valid until the next insertion; nullptr if not cached.
+                 */
+                inline V* Find (const K& a_key)
+                {
+                    return Find(a_key, [] (const V&) -> bool { return true; });
+                }
+
+                /**
+                 * @brief Look up an entry that may be stale, see \link Find \link.
+                 *
+                 * @param a_key
+                 * @param a_fresh bool ( const V& ), a stale entry is released and accounted as a miss.
+                 */
+                template <typename F>
+                inline V* Find (const K& a_key, F&& a_fresh)
+                {
+                    const auto it = index_.find(a_key);
+                    if ( index_.end() == it ) {
+                        Miss();
+                        return nullptr;
+                    }
+                    if ( false == a_fresh(it->second->value_) ) {
+                        Drop(it->second, /* a_evicted */ false);
+                        Miss();
+                        return nullptr;
+                    }
+                    Hit();
+
+                    // ... move to front ...
+                    entries_.splice(entries_.begin(), entries_, it->second);
+                    it->second->tick_ = Touch();
+
+                    return &it->second->value_;
+                }
+
+                /**
+                 * @brief Insert or replace an entry, evicting least recently used ones to honor both limits.
+                 *
+                 * @param a_key
+                 * @param a_value
+                 * @param a_bytes Memory held by \p a_value besides it's own size, e.g. a string's characters.
+                 *
+                 * @return Value owned by the cache, valid until the next insertion - it's never evicted by it's own one.
+                 */
+                inline V& Insert (const K& a_key, V&& a_value, const size_t a_bytes)
+                {
+                    const auto it = index_.find(a_key);
+                    if ( index_.end() != it ) {
+                        Drop(it->second, /* a_evicted */ false);
+                    }
+                    while ( entries_.size() >= limit_ && false == entries_.empty() ) {
+                        Drop(std::prev(entries_.end()), /* a_evicted */ true);
+                    }
+
+                    entries_.emplace_front(a_key, std::move(a_value), k_overhead_ + a_bytes, Touch());
+                    index_[a_key] = entries_.begin();
+                    Added(entries_.front().bytes_);
+
+                    return entries_.front().value_;
+                }
+
+                /**
+                 * @brief Release all entries matching a predicate.
+                 *
+                 * @param a_match bool ( const K&, const V& ).
+                 *
+                 * @return Number of entries released.
+                 */
+                template <typename P>
+                inline size_t EraseIf (P&& a_match)
+                {
+                    size_t count = 0;
+                    for ( auto it = entries_.begin() ; entries_.end() != it ; ) {
+                        const auto current = it++;
+                        if ( true == a_match(current->key_, current->value_) ) {
+                            Drop(current, /* a_evicted */ false);
+                            ++count;
+                        }
+                    }
+                    return count;
+                }
+
+                /**
+                 * @brief Change the maximum number of entries, least recently used ones are evicted.
+                 *
+                 * @param a_limit
+                 */
+                inline void Limit (const size_t a_limit)
+                {
+                    limit_ = a_limit;
+                    while ( entries_.size() > limit_ ) {
+                        Drop(std::prev(entries_.end()), /* a_evicted */ true);
+                    }
+                }
+
+                /**
+                 * @return Maximum number of entries.
+                 */
+                inline size_t Limit () const
+                {
+                    return limit_;
+                }
+
+            private: // Method(s) / Function(s)
+
+                /**
+                 * @brief Release an entry.
+                 *
+                 * @param a_it
+                 * @param a_evicted
+                 */
+                inline void Drop (const typename Entries::iterator a_it, const bool a_evicted)
+                {
+                    R()(a_it->key_, a_it->value_);
+                    Removed(a_it->bytes_, a_evicted);
+                    index_.erase(a_it->key_);
+                    entries_.erase(a_it);
+                }
+
+            }; // end of class 'LRUCache'
+
+        } // end of namespace 'utils'
+
+    } // end of namespace 'cpp'
+
+} // end of namespace 'pg'
+
+#endif // PG_CPP_UTILS_CACHE_H_
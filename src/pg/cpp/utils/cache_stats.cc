@@ -0,0 +1,71 @@
+/**
+ * @file cache_stats.cc
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pg/cpp/utils/cache_stats.h"
+
+#include <inttypes.h> // PRIu64
+
+/**
+ * @brief Default constructor.
+ */
+pg::cpp::utils::CacheStats::CacheStats ()
+{
+    /* empty */
+}
+
+/**
+ * @brief Destructor.
+ */
+pg::cpp::utils::CacheStats::~CacheStats ()
+{
+    /* empty */
+}
+
+/**
+ * @brief Fill user provided context information, one record per cache.
+ *
+ * @param a_context
+ */
+void pg::cpp::utils::CacheStats::FillOutputAtUserFuncContext (FuncCallContext* a_context)
+{
+    Utility::Records* records = Utility::UserFuncContextRecords(a_context);
+    for ( auto& cache : caches_ ) {
+        char** values = records->Append(6);
+        values[0] = records->Copy(cache.first);
+        values[1] = records->Format("%" PRIu64, cache.second.entries_);
+        values[2] = records->Format("%" PRIu64, cache.second.bytes_);
+        values[3] = records->Format("%" PRIu64, cache.second.hits_);
+        values[4] = records->Format("%" PRIu64, cache.second.misses_);
+        values[5] = records->Format("%" PRIu64, cache.second.evictions_);
+        a_context->max_calls += 1;
+    }
+}
+
+/**
+ * @brief Take a snapshot of this backend's caches counters.
+ */
+void pg::cpp::utils::CacheStats::Collect ()
+{
+    caches_.clear();
+    for ( const Cache* cache = Cache::First() ; nullptr != cache ; cache = cache->Next() ) {
+        caches_.push_back(std::make_pair(cache->Name(), cache->Usage()));
+    }
+}
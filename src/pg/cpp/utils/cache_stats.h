@@ -0,0 +1,72 @@
+/**
+ * @file cache_stats.h
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef PG_CPP_UTILS_CACHE_STATS_H_
+#define PG_CPP_UTILS_CACHE_STATS_H_
+
+#include "pg/cpp/utils/utility.h"
+#include "pg/cpp/utils/cache.h"
+
+#include <utility> // std::pair
+#include <vector>  // std::vector
+
+namespace pg
+{
+
+    namespace cpp
+    {
+
+        namespace utils
+        {
+
+            /**
+             * @brief This backend's \link Cache \link counters, one record per cache.
+             */
+            class CacheStats final : public Utility
+            {
+
+            private: // Data
+
+                std::vector<std::pair<const char*, Cache::Counters>> caches_;
+
+            public: // Constructor / Destructor.
+
+                CacheStats ();
+                virtual ~CacheStats();
+
+            public: // Inherited Pure Virtual Method(s) / Function(s)
+
+                virtual void FillOutputAtUserFuncContext (FuncCallContext* a_context);
+
+            public: // Method(s) / Function(s)
+
+                void Collect ();
+
+            }; // end of class 'CacheStats'
+
+        } // end of namespace 'utils'
+
+    } // end of namespace 'cpp'
+
+} // end of namespace 'pg'
+
+#endif // PG_CPP_UTILS_CACHE_STATS_H_
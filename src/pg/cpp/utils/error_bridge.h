@@ -0,0 +1,250 @@
+/**
+ * @file error_bridge.h
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#ifndef PG_CPP_UTILS_ERROR_BRIDGE_H_
+#define PG_CPP_UTILS_ERROR_BRIDGE_H_
+
+#include "pg/postgres.h"
+
+#include "pg/cpp/utils/exception.h"
+#include "pg/cpp/utils/status.h"
+
+#include <stdarg.h> // va_list
+#include <string.h> // strlen, memcpy
+
+#include <exception> // std::exception, std::exception_ptr
+#include <new>       // std::bad_alloc
+#include <string>    // std::string
+
+namespace pg
+{
+
+    namespace cpp
+    {
+
+        namespace utils
+        {
+
+            /**
+             * @brief Bridge between postgres errors ( ereport, a longjmp ) and C++ exceptions ( stack unwinding ).
+             *
+             * @remarks A longjmp skips C++ destructors, so errors must never be raised while C++ objects are alive:
+             *          postgres errors are turned into \link Error \link exceptions by \link Call \link and raised
+             *          again by \link Guard \link, once the C++ stack it guards is gone.
+             */
+            class ErrorBridge final
+            {
+
+            public: // Data Type(s)
+
+                /**
+                 * @brief A postgres error travelling as a C++ exception.
+                 */
+                class Error final : public std::exception
+                {
+
+                private: // Data
+
+                    ErrorData*  data_; // copied from postgres, nullptr when raised by C++ code
+                    int         code_;
+                    std::string message_;
+
+                public: // Constructor(s) / Destructor
+
+                    /**
+                     * @brief A postgres error, see \link Call \link.
+                     *
+                     * @param a_data Copy of the error, raised again as is.
+                     */
+                    Error (ErrorData* a_data)
+                        : data_(a_data), code_(a_data->sqlerrcode), message_(nullptr != a_data->message ? a_data->message : "")
+                    {
+                        /* empty */
+                    }
+
+                    Error (const int a_code, const char* const a_format, ...) __attribute__((format(printf, 3, 4)));
+
+                    /**
+                     * @brief Destructor.
+                     */
+                    virtual ~Error () throw ()
+                    {
+                        /* empty */
+                    }
+
+                public: // Method(s) / Function(s)
+
+                    /**
+                     * @return The postgres error, nullptr if raised by C++ code.
+                     */
+                    inline ErrorData* Data () const
+                    {
+                        return data_;
+                    }
+
+                    /**
+                     * @return SQLSTATE, see ERRCODE_*.
+                     */
+                    inline int Code () const
+                    {
+                        return code_;
+                    }
+
+                    virtual const char* what () const throw ()
+                    {
+                        return message_.c_str();
+                    }
+
+                }; // end of class 'Error'
+
+            public: // Static Method(s) / Function(s)
+
+                template <typename Func> static Datum Guard (Func&& a_func);
+                template <typename Func> static void  Call  (Func&& a_func);
+
+            private: // Static Method(s) / Function(s)
+
+                static const char* Copy (const char* const a_message);
+
+            }; // end of class 'ErrorBridge'
+
+            /**
+             * @brief A C++ raised error.
+             *
+             * @param a_code   SQLSTATE, see ERRCODE_*.
+             * @param a_format printf like format followed by a variable number of arguments.
+             * @param ...
+             */
+            inline ErrorBridge::Error::Error (const int a_code, const char* const a_format, ...)
+                : data_(nullptr), code_(a_code)
+            {
+                va_list args;
+
+                va_start(args, a_format);
+                Status::Format(message_, a_format, args);
+                va_end(args);
+            }
+
+            /**
+             * @brief Run C++ code on behalf of postgres, e.g. a function's body, and raise whatever it throws as a postgres
+             *        error - only after all of it's C++ state, the exception included, is destroyed.
+             *
+             * @param a_func Datum ().
+             *
+             * @return \p a_func result.
+             */
+            template <typename Func>
+            inline Datum ErrorBridge::Guard (Func&& a_func)
+            {
+                ErrorData*  data    = nullptr;
+                int         code    = ERRCODE_FEATURE_NOT_SUPPORTED;
+                const char* message = nullptr;
+                Datum       result  = (Datum) 0;
+
+                try {
+                    result = a_func();
+                } catch (const Error& a_error) {
+                    data    = a_error.Data();
+                    code    = a_error.Code();
+                    message = Copy(a_error.what());
+                } catch (const pg::cpp::utils::Exception& a_pg_cpp_utils_exception) {
+                    message = Copy(a_pg_cpp_utils_exception.what());
+                } catch (const std::bad_alloc&) {
+                    code    = ERRCODE_OUT_OF_MEMORY;
+                    message = "C++ Bad Alloc";
+                } catch (...) {
+                    message = "Unexpected exception generic caught!";
+                }
+
+                // ... no C++ state is left for a longjmp to skip ...
+                if ( nullptr != data ) {
+                    ReThrowError(data);
+                }
+                if ( nullptr != message ) {
+                    ereport(ERROR, (errcode(code), errmsg("%s", message)));
+                }
+
+                return result;
+            }
+
+            /**
+             * @brief Run postgres code on behalf of C++ code, e.g. SPI or detoasting while C++ objects are alive: an error it
+             *        raises is copied and thrown as an \link Error \link, so C++ destructors do run.
+             *
+             * @param a_func void (), must not own C++ state - a longjmp out of it skips it's destructors.
+             *
+             * @remarks The error is flushed, until \link Guard \link raises it again only cleanup may run - as in a PG_CATCH block.
+             */
+            template <typename Func>
+            inline void ErrorBridge::Call (Func&& a_func)
+            {
+                MemoryContext      context   = CurrentMemoryContext;
+                ErrorData*         data      = nullptr;
+                std::exception_ptr exception = nullptr;
+
+                PG_TRY();
+                {
+                    // ... nor may a C++ exception leave PG_TRY, postgres would longjmp to this frame later on ...
+                    try {
+                        a_func();
+                    } catch (...) {
+                        exception = std::current_exception();
+                    }
+                }
+                PG_CATCH();
+                {
+                    MemoryContextSwitchTo(context);
+                    data = CopyErrorData();
+                    FlushErrorState();
+                }
+                PG_END_TRY();
+
+                if ( nullptr != data ) {
+                    throw Error(data);
+                }
+                if ( nullptr != exception ) {
+                    std::rethrow_exception(exception);
+                }
+            }
+
+            /**
+             * @brief Copy a message to the current memory context, without raising an error if out of memory.
+             *
+             * @param a_message
+             */
+            inline const char* ErrorBridge::Copy (const char* const a_message)
+            {
+                const size_t length = strlen(a_message);
+                char*        copy   = static_cast<char*>(MemoryContextAllocExtended(CurrentMemoryContext, length + 1, MCXT_ALLOC_NO_OOM));
+                if ( nullptr == copy ) {
+                    return "out of memory";
+                }
+                memcpy(copy, a_message, length + 1);
+                return copy;
+            }
+
+        } // end of namespace 'utils'
+
+    } // end of namespace 'cpp'
+
+} // end of namespace 'pg'
+
+#endif // PG_CPP_UTILS_ERROR_BRIDGE_H_
@@ -0,0 +1,87 @@
+/**
+ * @file icu_data.cc
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "pg/cpp/utils/icu_data.h"
+
+#include <unicode/udata.h> // udata_setCommonData
+
+#include <sys/mman.h> // mmap, munmap
+#include <sys/stat.h> // fstat
+#include <fcntl.h>    // open
+#include <unistd.h>   // close
+#include <errno.h>    // errno
+#include <string.h>   // strerror
+
+const void* pg::cpp::utils::ICUData::s_data_ = nullptr;
+size_t      pg::cpp::utils::ICUData::s_size_ = 0;
+
+/**
+ * @brief Map an ICU data package and make it ICU's common data, must be called once - before ICU loads any data.
+ *
+ * @param a_path
+ * @param o_status Set to failed when the package can't be mapped or ICU refuses it.
+ *
+ * @return False, with \p o_status set, on failure - ICU keeps using the data linked into the module.
+ */
+bool pg::cpp::utils::ICUData::Load (const char* const a_path, pg::cpp::utils::Status& o_status)
+{
+    if ( nullptr != s_data_ ) {
+        return o_status.Fail("ICU data package already loaded");
+    }
+
+    const int fd = open(a_path, O_RDONLY | O_CLOEXEC);
+    if ( -1 == fd ) {
+        const int err = errno;
+        return o_status.Fail("Unable to open ICU data package '%s': %s", a_path, strerror(err));
+    }
+
+    struct stat st;
+    if ( 0 != fstat(fd, &st) ) {
+        const int err = errno;
+        close(fd);
+        return o_status.Fail("Unable to access ICU data package '%s': %s", a_path, strerror(err));
+    }
+    if ( st.st_size <= 0 ) {
+        close(fd);
+        return o_status.Fail("ICU data package '%s' is empty", a_path);
+    }
+
+    // ... read-only and shared, backends share the page cache's pages ...
+    const size_t size = static_cast<size_t>(st.st_size);
+    void*        data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    const int    err  = errno;
+    close(fd);
+    if ( MAP_FAILED == data ) {
+        return o_status.Fail("Unable to map ICU data package '%s': %s", a_path, strerror(err));
+    }
+
+    UErrorCode icu_error_code = U_ZERO_ERROR;
+    udata_setCommonData(data, &icu_error_code);
+    if ( U_FAILURE(icu_error_code) ) {
+        munmap(data, size);
+        return o_status.Fail("ICU refused data package '%s': %s", a_path, u_errorName(icu_error_code));
+    }
+
+    // ... ICU keeps pointing at it, so it's never unmapped ...
+    s_data_ = data;
+    s_size_ = size;
+
+    return true;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file icu_data.h
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#ifndef PG_CPP_UTILS_ICU_DATA_H_
+#define PG_CPP_UTILS_ICU_DATA_H_
+
+#include "pg/cpp/utils/status.h"
+
+#include <stddef.h> // size_t
+
+namespace pg
+{
+
+    namespace cpp
+    {
+
+        namespace utils
+        {
+
+            /**
+             * @brief ICU data package ( .dat, see icupkg ) memory mapped read-only and handed to ICU as it's common data, so
+             *        backends share it's pages and only the resources they touch are read.
+             *
+             * @remarks Items not in the package are still looked up in the ICU data linked into the module, if any.
+             */
+            class ICUData final
+            {
+
+            private: // Static Data
+
+                static const void* s_data_;
+                static size_t      s_size_;
+
+            public: // Static Method(s) / Function(s)
+
+                static bool   Load     (const char* const a_path, Status& o_status);
+                static bool   IsLoaded ();
+                static size_t Size     ();
+
+            }; // end of class 'ICUData'
+
+            /**
+             * @return True once a package was loaded.
+             */
+            inline bool ICUData::IsLoaded ()
+            {
+                return nullptr != s_data_;
+            }
+
+            /**
+             * @return Mapped package size, 0 if none.
+             */
+            inline size_t ICUData::Size ()
+            {
+                return s_size_;
+            }
+
+        } // end of namespace 'utils'
+
+    } // end of namespace 'cpp'
+
+} // end of namespace 'pg'
+
+#endif // PG_CPP_UTILS_ICU_DATA_H_
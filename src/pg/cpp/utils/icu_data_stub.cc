@@ -0,0 +1,68 @@
+/**
+ * @file icu_data_stub.cc
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+ * Empty ICU common data, linked instead of libicudata.a when building with ICU_DATA=trimmed: all ICU data then comes
+ * from the package loaded by \link pg::cpp::utils::ICUData \link.
+ */
+
+#include <unicode/utypes.h> // U_ICUDATA_ENTRY_POINT
+#include <unicode/udata.h>  // UDataInfo
+
+#include <stdint.h> // uint8_t, uint16_t, uint32_t
+
+/**
+ * @brief Common data header with an empty table of contents, as ICU's own stubdata.
+ */
+typedef struct {
+    uint16_t  header_size_;
+    uint8_t   magic1_;
+    uint8_t   magic2_;
+    UDataInfo info_;
+    char      padding_[8];
+    uint32_t  count_;
+    uint32_t  reserved_;
+    int       toc_[4]; // one, unused, name and data entry
+} PgCppUtilsICUDataStub;
+
+extern "C" U_EXPORT const PgCppUtilsICUDataStub U_ICUDATA_ENTRY_POINT = {
+    32,   /* header_size_ */
+    0xda, /* magic1_ */
+    0x27, /* magic2_ */
+    {
+        sizeof(UDataInfo),
+        0,
+#if U_IS_BIG_ENDIAN
+        1,
+#else
+        0,
+#endif
+        U_CHARSET_FAMILY,
+        U_SIZEOF_UCHAR,
+        0,
+        { 0x54, 0x6f, 0x43, 0x50 }, /* dataFormat "ToCP" */
+        { 1, 0, 0, 0 },             /* formatVersion */
+        { 0, 0, 0, 0 }              /* dataVersion */
+    },
+    { 0, 0, 0, 0, 0, 0, 0, 0 },
+    0,
+    0,
+    { 0, 0, 0, 0 }
+};
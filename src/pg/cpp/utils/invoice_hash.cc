@@ -24,20 +24,24 @@
 #include "pg/cpp/utils/exception.h"
 #include "pg/cpp/utils/b64.h"
 
-#include <openssl/pem.h>
-#include <openssl/sha.h>
-#include <openssl/rsa.h>
-#include <openssl/evp.h>
+#include "cppcodec/base64_rfc4648.hpp"
 
-#include <stdio.h> // strerror
+#include <string.h> // memcpy, strlen
+#include <signal.h> // pthread_sigmask
+
+#include <thread>       // std::thread
+#include <atomic>       // std::atomic
+#include <algorithm>    // std::min
+#include <system_error> // std::system_error
 
 /**
  * @brief Default constructor.
  *
- * @param a_pem_uri
+ * @param a_key        Private key when signing, public key ( or certificate ) when verifying.
+ * @param a_key_source PEM file path, or PEM / DER key material.
  */
-pg::cpp::utils::InvoiceHash::InvoiceHash (const std::string& a_pem_uri)
-    : pem_uri_(a_pem_uri)
+pg::cpp::utils::InvoiceHash::InvoiceHash (const pg::cpp::utils::StringView& a_key, const pg::cpp::utils::KeyCache::Source a_key_source)
+    : key_(a_key.ToString()), key_source_(a_key_source), verify_(false), valid_(false), cursor_(0), batch_slot_size_(0)
 {
     /* emtpy */
 }
@@ -57,120 +61,304 @@ pg::cpp::utils::InvoiceHash::~InvoiceHash ()
  */
 void pg::cpp::utils::InvoiceHash::FillOutputAtUserFuncContext (FuncCallContext* a_context)
 {
-    Utility::Records* records = static_cast<Utility::Records*>(a_context->user_fctx);
-    records->Append(new pg::cpp::utils::InvoiceHash::Record(long_, short_));
+    Utility::Records* records = Utility::UserFuncContextRecords(a_context);
+    if ( true == verify_ ) {
+        records->Append({ valid_ ? "t" : "f" });
+    } else {
+        char** values = records->Append(2);
+        values[0] = records->Copy(long_);
+        values[1] = records->Copy(short_);
+    }
     a_context->max_calls += 1;
 }
 
 /**
- * @brief Calculate a payload hash.
+ * @brief Calculate, or verify, the next payload hash of a batch.
  *
- * @param a_payload
+ * @param a_records
+ *
+ * @return False when the batch is exhausted.
  *
  * @throw
  */
-void pg::cpp::utils::InvoiceHash::Calculate (const std::string& a_payload)
+bool pg::cpp::utils::InvoiceHash::Next (Utility::Records& a_records)
 {
-    bool           ctx_initialized  = false;
-    EVP_MD_CTX     ctx;
-    EVP_PKEY*      pkey             = nullptr;
-    RSA*           rsa_pkey         = nullptr;
-    FILE*          private_key_file = nullptr;
-    unsigned char* signature_bytes  = nullptr;
-    unsigned int   signature_len    = 0;
-    pg::cpp::utils::B64       b64;
-
-    const auto cleanup = [&pkey, &private_key_file, &signature_bytes, &ctx_initialized, &ctx] () {
-
-        if ( nullptr != signature_bytes ) {
-            delete [] signature_bytes;
+    if ( cursor_ >= batch_.size() ) {
+        return false;
+    }
+    const size_t idx = cursor_++;
+    if ( true == verify_ ) {
+        char** values = a_records.Append(1);
+        if ( true == batch_nulls_[idx] ) {
+            return true;
         }
-
-        if ( nullptr != pkey ) {
-            EVP_PKEY_free(pkey);
+        Verify(batch_[idx], batch_hashes_[idx]);
+        values[0] = a_records.Copy(valid_ ? "t" : "f");
+    } else {
+        char** values = a_records.Append(2);
+        if ( true == batch_nulls_[idx] ) {
+            return true;
         }
-
-        if ( nullptr != private_key_file ) {
-            fclose(private_key_file);
+        if ( 0 != batch_buffer_.size() ) {
+            // ... already signed by SignBatch ...
+            long_ = &batch_buffer_[idx * batch_slot_size_];
+            if ( false == Shorten() ) {
+                return true;
+            }
+        } else {
+            Calculate(batch_[idx]);
+            if ( true == status_.Failed() ) {
+                return true;
+            }
         }
+        values[0] = a_records.Copy(long_);
+        values[1] = a_records.Copy(short_);
+    }
+    return true;
+}
 
-        if ( true == ctx_initialized ) {
-            EVP_MD_CTX_cleanup(&ctx);
-            ctx_initialized = false;
+/**
+ * @brief Prepare a batch of payloads to be hashed, one per \link Next \link call.
+ *
+ * @param a_payloads Views that must outlive the batch.
+ * @param a_nulls
+ * @param a_workers  When greater than 1, all payloads are signed upfront by up to this number of threads, see \link SignBatch \link.
+ */
+void pg::cpp::utils::InvoiceHash::CalculateBatch (const std::vector<pg::cpp::utils::StringView>& a_payloads, const std::vector<bool>& a_nulls,
+                                                  const size_t a_workers)
+{
+    batch_       = a_payloads;
+    batch_nulls_ = a_nulls;
+    batch_hashes_.clear();
+    batch_buffer_.clear();
+    verify_      = false;
+    cursor_      = 0;
+
+    if ( a_workers > 1 && batch_.size() > 1 ) {
+        // ... parsed once per backend, see KeyCache ...
+        EVP_PKEY* pkey = pg::cpp::utils::KeyCache::Get(key_, pg::cpp::utils::KeyCache::Type::Private, key_source_, status_);
+        if ( nullptr == pkey ) {
+            return;
         }
+        SignBatch(pkey, a_workers);
+    }
+}
 
-    };
+/**
+ * @brief Prepare a batch of payloads / hashes to be verified, one per \link Next \link call.
+ *
+ * @param a_payloads    Views that must outlive the batch.
+ * @param a_long_hashes
+ * @param a_nulls       True if either the payload or the hash is null.
+ */
+void pg::cpp::utils::InvoiceHash::VerifyBatch (const std::vector<pg::cpp::utils::StringView>& a_payloads, const std::vector<pg::cpp::utils::StringView>& a_long_hashes,
+                                               const std::vector<bool>& a_nulls)
+{
+    batch_        = a_payloads;
+    batch_hashes_ = a_long_hashes;
+    batch_nulls_  = a_nulls;
+    verify_       = true;
+    cursor_       = 0;
+}
 
-    long_  = "";
-    short_ = "";
-    tmp_ss_.str("");
+/**
+ * @brief Calculate a payload hash.
+ *
+ * @param a_payload
+ */
+void pg::cpp::utils::InvoiceHash::Calculate (const pg::cpp::utils::StringView& a_payload)
+{
+    pg::cpp::utils::B64 b64;
+
+    verify_ = false;
+    long_   = "";
+    short_  = "";
 
     try {
 
-        pkey             = EVP_PKEY_new();
-        private_key_file = fopen(pem_uri_.c_str(), "r");
-        if ( nullptr == private_key_file ) {
-            int err = errno;
-            throw PG_CPP_UTILS_EXCEPTION("Unable to open RSA private key file '%s' : %s!",
-                                         pem_uri_.c_str(), strerror(err)
-            );
+        // ... parsed once per backend, see KeyCache ...
+        EVP_PKEY* pkey = pg::cpp::utils::KeyCache::Get(key_, pg::cpp::utils::KeyCache::Type::Private, key_source_, status_);
+        if ( nullptr == pkey ) {
+            return;
         }
 
-        if ( ! PEM_read_RSAPrivateKey(private_key_file, &rsa_pkey, NULL, NULL) ) {
-            throw PG_CPP_UTILS_EXCEPTION_NA("Error while loading RSA private key File!");
+        // ... certified invoice hashes are RSA-SHA1, PKCS #1 v1.5 ...
+        const std::vector<unsigned char>* signature = signer_.Sign(pkey, pg::cpp::utils::Signer::Algorithm::RSA_SHA1,
+                                                                   a_payload.Data(), a_payload.Length(), status_);
+        if ( nullptr == signature ) {
+            return;
         }
 
-        if ( ! EVP_PKEY_assign_RSA(pkey, rsa_pkey) ) {
-            throw PG_CPP_UTILS_EXCEPTION_NA("Error while assigning RSA!");
-        }
+        long_ = b64.Encode(signature->data(), static_cast<unsigned int>(signature->size()));
 
-        EVP_MD_CTX_init(&ctx);
-        ctx_initialized = true;
+        (void)Shorten();
 
-        if ( ! EVP_SignInit(&ctx, EVP_sha1()) ) {
-            throw PG_CPP_UTILS_EXCEPTION_NA("Error while setting up signing context!");
-        }
+    } catch (const std::bad_alloc& a_bad_alloc) {
+        status_.Fail("C++ Bad Alloc: %s", a_bad_alloc.what());
+    } catch (const std::runtime_error& a_rte) {
+        status_.Fail("C++ Runtime Error: %s", a_rte.what());
+    } catch (const std::exception& a_std_exception) {
+        status_.Fail("C++ Standard Exception: %s", a_std_exception.what());
+    } catch (...) {
+        status_.Fail("C++ Generic Exception: %s", PG_CPP_UTILS_EXCEPTION_TRACE_CPP_GENERIC_EXCEPTION().c_str());
+    }
 
-        if ( ! EVP_SignUpdate(&ctx, a_payload.c_str(), a_payload.length() ) ) {
-            throw PG_CPP_UTILS_EXCEPTION_NA("Error while updating signing context");
-        }
+}
 
-        signature_bytes = new unsigned char[EVP_PKEY_size(pkey)];
-        if ( !EVP_SignFinal(&ctx, signature_bytes, &signature_len, pkey) ) {
-            throw PG_CPP_UTILS_EXCEPTION_NA("Error while finalizing signing context!");
-        }
+/**
+ * @brief Verify a payload hash.
+ *
+ * @param a_payload
+ * @param a_long_hash Base 64 RSA-SHA1 signature, as calculated by \link Calculate \link.
+ */
+void pg::cpp::utils::InvoiceHash::Verify (const pg::cpp::utils::StringView& a_payload, const pg::cpp::utils::StringView& a_long_hash)
+{
+    verify_ = true;
+    valid_  = false;
 
-        long_ = b64.Encode(signature_bytes, signature_len);
+    try {
 
-        const size_t hash_length = long_.length();
-        if ( hash_length != 172 ) {
-            throw PG_CPP_UTILS_EXCEPTION("Error while encoding signature to B64 - got %zd (bytes), expected %d bytes!",
-                                         hash_length,
-                                         172
-            );
+        // ... parsed once per backend, see KeyCache ...
+        EVP_PKEY* pkey = pg::cpp::utils::KeyCache::Get(key_, pg::cpp::utils::KeyCache::Type::Public, key_source_, status_);
+        if ( nullptr == pkey ) {
+            return;
         }
 
-        const char* const long_c_str = long_.c_str();
-        tmp_ss_ << long_c_str[0] << long_c_str[10] << long_c_str[20] << long_c_str[30];
-        short_ = tmp_ss_.str();
+        // ... a hash that is not base 64 can't be valid ...
+        try {
+            signature_bytes_.resize(cppcodec::base64_rfc4648::decoded_max_size(a_long_hash.Length()));
+            signature_bytes_.resize(cppcodec::base64_rfc4648::decode(signature_bytes_.data(), signature_bytes_.size(),
+                                                                     a_long_hash.Data(), a_long_hash.Length()));
+        } catch (const cppcodec::parse_error&) {
+            valid_ = false;
+            return;
+        }
 
-        cleanup();
+        valid_ = signer_.Verify(pkey, pg::cpp::utils::Signer::Algorithm::RSA_SHA1, a_payload.Data(), a_payload.Length(),
+                                signature_bytes_.data(), signature_bytes_.size(), status_);
 
-    } catch (const pg::cpp::utils::Exception& a_pg_cpp_utils_exception) {
-        cleanup();
-        throw a_pg_cpp_utils_exception;
-    }  catch (const std::bad_alloc& a_bad_alloc) {
-        cleanup();
-        throw PG_CPP_UTILS_EXCEPTION("C++ Bad Alloc: %s", a_bad_alloc.what());
+    } catch (const std::bad_alloc& a_bad_alloc) {
+        status_.Fail("C++ Bad Alloc: %s", a_bad_alloc.what());
     } catch (const std::runtime_error& a_rte) {
-        cleanup();
-        throw PG_CPP_UTILS_EXCEPTION("C++ Runtime Error: %s", a_rte.what());
+        status_.Fail("C++ Runtime Error: %s", a_rte.what());
     } catch (const std::exception& a_std_exception) {
-        cleanup();
-        throw PG_CPP_UTILS_EXCEPTION("C++ Standard Exception: %s", a_std_exception.what());
+        status_.Fail("C++ Standard Exception: %s", a_std_exception.what());
     } catch (...) {
-        cleanup();
-        throw PG_CPP_UTILS_EXCEPTION("C++ Generic Exception: %s", PG_CPP_UTILS_EXCEPTION_TRACE_CPP_GENERIC_EXCEPTION().c_str());
+        status_.Fail("C++ Generic Exception: %s", PG_CPP_UTILS_EXCEPTION_TRACE_CPP_GENERIC_EXCEPTION().c_str());
+    }
+}
+
+/**
+ * @brief Sign all non null payloads of a batch, fanning them out across worker threads.
+ *
+ * @remarks Workers only use OpenSSL and the C++ heap - never palloc, elog or the key cache - and write into a buffer
+ *          preallocated here; the calling ( backend ) thread signs alongside them.
+ *
+ * @param a_pkey    Private key, already obtained from \link KeyCache \link.
+ * @param a_workers Maximum number of threads, including the calling one.
+ */
+void pg::cpp::utils::InvoiceHash::SignBatch (EVP_PKEY* a_pkey, const size_t a_workers)
+{
+    const size_t count   = batch_.size();
+    const size_t workers = std::min(a_workers, count);
+
+    // ... one NUL terminated base 64 signature per payload ...
+    batch_slot_size_ = ( ( static_cast<size_t>(EVP_PKEY_size(a_pkey)) + 2 ) / 3 ) * 4 + 1;
+    batch_buffer_.assign(count * batch_slot_size_, '\0');
+
+    // ... the digest is fetched lazily, workers must only read it ...
+    (void)pg::cpp::utils::Signer::Digest(pg::cpp::utils::Signer::Algorithm::RSA_SHA1, status_);
+    if ( true == status_.Failed() ) {
+        batch_buffer_.clear();
+        return;
     }
 
+    std::atomic<size_t>                 next(0);
+    std::atomic<bool>                   failed(false);
+    std::vector<pg::cpp::utils::Status> statuses(workers);
+    std::vector<std::thread>            threads;
+
+    const auto work = [this, a_pkey, count, &next, &failed, &statuses] (const size_t a_worker) {
+        pg::cpp::utils::Status& status = statuses[a_worker];
+        try {
+            pg::cpp::utils::Signer signer;
+            pg::cpp::utils::B64    b64;
+            for ( size_t idx = next++ ; idx < count && false == failed ; idx = next++ ) {
+                if ( true == batch_nulls_[idx] ) {
+                    continue;
+                }
+                const std::vector<unsigned char>* signature = signer.Sign(a_pkey, pg::cpp::utils::Signer::Algorithm::RSA_SHA1,
+                                                                          batch_[idx].Data(), batch_[idx].Length(), status);
+                if ( nullptr == signature ) {
+                    failed = true;
+                    return;
+                }
+                const char* const encoded = b64.Encode(signature->data(), static_cast<unsigned int>(signature->size()));
+                const size_t      length  = strlen(encoded);
+                if ( length >= batch_slot_size_ ) {
+                    status.Fail("Error while encoding signature to B64 - got %zd (bytes), expected at most %zd bytes!", length, batch_slot_size_ - 1);
+                    failed = true;
+                    return;
+                }
+                memcpy(&batch_buffer_[idx * batch_slot_size_], encoded, length);
+            }
+        } catch (const std::exception& a_std_exception) {
+            status.Fail("%s", a_std_exception.what());
+            failed = true;
+        } catch (...) {
+            status.Fail("C++ Generic Exception");
+            failed = true;
+        }
+    };
+
+    // ... signals must keep being delivered to the backend thread only ...
+    sigset_t all_signals;
+    sigset_t previous_signals;
+    sigfillset(&all_signals);
+    pthread_sigmask(SIG_SETMASK, &all_signals, &previous_signals);
+    threads.reserve(workers - 1);
+    for ( size_t idx = 1 ; idx < workers ; ++idx ) {
+        try {
+            threads.push_back(std::thread(work, idx));
+        } catch (const std::system_error&) {
+            // ... fewer workers, the calling thread signs whatever is left ...
+            break;
+        }
+    }
+    pthread_sigmask(SIG_SETMASK, &previous_signals, nullptr);
+
+    work(0);
+    for ( auto& thread : threads ) {
+        thread.join();
+    }
+
+    if ( true == failed ) {
+        batch_buffer_.clear();
+        for ( const auto& status : statuses ) {
+            if ( true == status.Failed() ) {
+                status_ = status;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Validate the current long hash and derive the short one from it.
+ *
+ * @return False, with the status set, when the long hash is not a certified invoice hash.
+ */
+bool pg::cpp::utils::InvoiceHash::Shorten ()
+{
+    const size_t hash_length = long_.length();
+    if ( hash_length != 172 ) {
+        return status_.Fail("Error while encoding signature to B64 - got %zd (bytes), expected %d bytes!", hash_length, 172);
+    }
+
+    const char* const long_c_str = long_.c_str();
+    tmp_ss_.str("");
+    tmp_ss_ << long_c_str[0] << long_c_str[10] << long_c_str[20] << long_c_str[30];
+    short_ = tmp_ss_.str();
+
+    return true;
 }
@@ -24,9 +24,13 @@
 #define PG_CPP_UTILS_INVOICE_HASH_H_
 
 #include "pg/cpp/utils/utility.h"
+#include "pg/cpp/utils/key_cache.h"
+#include "pg/cpp/utils/signer.h"
+#include "pg/cpp/utils/string_view.h"
 
 #include <string>     // std::string
 #include <sstream>    // std::stringstream
+#include <vector>     // std::vector
 #include <functional> // std::function
 
 namespace pg
@@ -41,94 +45,53 @@ namespace pg
             class InvoiceHash final : public Utility
             {
 
-            public: // Data Type(s)
-
-                class Record final : public Utility::Record
-                {
-
-                public: // Const Data
-
-                    const std::string long_;
-                    const std::string short_;
-
-                private: // Data
-
-                    char** p_string_values_;
-
-                public: // Constructor / Destructor
-
-                    /**
-                     * @brief Default constructor.
-                     *
-                     * @param a_long
-                     * @param a_short
-                     */
-                    Record (const std::string& a_long, const std::string& a_short)
-                    : long_(a_long), short_(a_short)
-                    {
-                        p_string_values_ = nullptr;
-                    }
-
-                    /**
-                     * @brief Destructor.
-                     */
-                    virtual ~Record ()
-                    {
-                        if ( nullptr != p_string_values_ ) {
-                            if ( nullptr != p_string_values_[0] ) {
-                                pfree(p_string_values_[0]);
-                            }
-                            if ( nullptr != p_string_values_[1] ) {
-                                pfree(p_string_values_[1]);
-                            }
-                            pfree(p_string_values_);
-                        }
-                    }
-
-                public: // Inherited Pure Virtual Method(s) / Function(s) - implementation
-
-                    /**
-                     * @brief Allocate memory from postgres pool and copy a record data to it.
-                     *
-                     * @return An array of string representing a record.
-                     */
-                    virtual char** PStringValues ()
-                    {
-                        char** tmp = (char**)palloc(sizeof(char*)*2);
-                        if ( nullptr == tmp ) {
-                            return nullptr;
-                        }
-
-                        tmp[0] = PCopyString(long_.c_str());
-                        tmp[1] = PCopyString(short_.c_str());
-
-                        return tmp;
-                    }
-
-                }; // end of 'Record' class
-
             private: // Const Data
 
-                const std::string pem_uri_;
+                const std::string      key_;
+                const KeyCache::Source key_source_;
 
             private: // Data
 
-                std::string       long_;
-                std::string       short_;
-                std::stringstream tmp_ss_;
+                std::string                long_;
+                std::string                short_;
+                std::stringstream          tmp_ss_;
+                bool                       verify_;
+                bool                       valid_;
+                std::vector<StringView>    batch_;            // views of the call arguments
+                std::vector<StringView>    batch_hashes_;
+                std::vector<bool>          batch_nulls_;
+                size_t                     cursor_;
+                Signer                     signer_;
+                std::vector<char>          batch_buffer_;     // workers output, one NUL terminated long hash per payload
+                size_t                     batch_slot_size_;
+                std::vector<unsigned char> signature_bytes_;  // decoded long hash, reused across rows
 
             public: // Constructor / Destructor.
 
-                InvoiceHash (const std::string& a_pem_uri);
+                InvoiceHash (const StringView& a_key, const KeyCache::Source a_key_source = KeyCache::Source::File);
                 virtual ~InvoiceHash();
 
             public: // Inherited Pure Virtual Method(s) / Function(s)
 
                 virtual void FillOutputAtUserFuncContext (FuncCallContext* a_context);
 
+            public: // Inherited Virtual Method(s) / Function(s)
+
+                virtual bool Next (Records& a_records);
+
             public: // Method(s) / Function(s)
 
-                void Calculate (const std::string& a_payload);
+                void Calculate      (const StringView& a_payload);
+                void CalculateBatch (const std::vector<StringView>& a_payloads, const std::vector<bool>& a_nulls,
+                                     const size_t a_workers = 1);
+                void Verify         (const StringView& a_payload, const StringView& a_long_hash);
+                void VerifyBatch    (const std::vector<StringView>& a_payloads, const std::vector<StringView>& a_long_hashes,
+                                     const std::vector<bool>& a_nulls);
+
+            private: // Method(s) / Function(s)
+
+                void SignBatch (EVP_PKEY* a_pkey, const size_t a_workers);
+                bool Shorten   ();
 
             }; // end of class 'InvoiceHash'
 
@@ -0,0 +1,197 @@
+/**
+ * @file key_cache.cc
+ *
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pg/cpp/utils/key_cache.h"
+
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+#include <openssl/err.h>
+
+#include <sys/stat.h> // stat
+#include <errno.h>    // errno
+#include <string.h>   // strerror
+
+pg::cpp::utils::LRUCache<std::string, pg::cpp::utils::KeyCache::Entry> pg::cpp::utils::KeyCache::s_cache_("keys");
+
+/**
+ * @brief Obtain a parsed key, parsing it only once per backend.
+ *
+ * @param a_key    PEM file path, or key material - see \link Source \link.
+ * @param a_type   Private key, or public key ( PUBLIC KEY or CERTIFICATE ).
+ * @param a_source
+ * @param o_status Set to failed when the key can't be loaded.
+ *
+ * @return Key owned by the cache, valid until \link Reset \link, until the file changes or until another cache entry
+ *         is inserted - it may then be evicted; nullptr on failure.
+ */
+EVP_PKEY* pg::cpp::utils::KeyCache::Get (const std::string& a_key, const pg::cpp::utils::KeyCache::Type a_type,
+                                         const pg::cpp::utils::KeyCache::Source a_source, pg::cpp::utils::Status& o_status)
+{
+    if ( Source::Memory == a_source ) {
+        return GetMemory(a_key, a_type, o_status);
+    }
+    return GetFile(a_key, a_type, o_status);
+}
+
+/**
+ * @brief Release all cached keys.
+ */
+void pg::cpp::utils::KeyCache::Reset ()
+{
+    (void)s_cache_.Clear();
+}
+
+/**
+ * @brief Obtain a parsed key from a PEM file, re-loading it only if it was modified since.
+ *
+ * @param a_uri
+ * @param a_type
+ * @param o_status
+ *
+ * @return See \link Get \link.
+ */
+EVP_PKEY* pg::cpp::utils::KeyCache::GetFile (const std::string& a_uri, const pg::cpp::utils::KeyCache::Type a_type, pg::cpp::utils::Status& o_status)
+{
+    struct stat st;
+    if ( 0 != stat(a_uri.c_str(), &st) ) {
+        const int err = errno;
+        o_status.Fail("Unable to access key file '%s' : %s!", a_uri.c_str(), strerror(err));
+        return nullptr;
+    }
+
+    const std::string key = ( Type::Private == a_type ? "private:file:" : "public:file:" ) + a_uri;
+
+    const Entry* entry = s_cache_.Find(key, [&st] (const Entry& a_entry) -> bool {
+        return a_entry.mtime_ == st.st_mtime && a_entry.size_ == st.st_size;
+    });
+    if ( nullptr != entry ) {
+        return entry->pkey_.get();
+    }
+
+    BIO* bio = BIO_new_file(a_uri.c_str(), "r");
+    if ( nullptr == bio ) {
+        const int err = errno;
+        ERR_clear_error();
+        o_status.Fail("Unable to open key file '%s' : %s!", a_uri.c_str(), strerror(err));
+        return nullptr;
+    }
+    EVP_PKEY* pkey = Load(bio, /* a_pem */ true, a_type);
+    BIO_free(bio);
+    if ( nullptr == pkey ) {
+        o_status.Fail("Error while loading %s key from '%s'!", Type::Private == a_type ? "private" : "public", a_uri.c_str());
+        return nullptr;
+    }
+
+    return Insert(key, pkey, st.st_mtime, st.st_size);
+}
+
+/**
+ * @brief Obtain a parsed key from PEM or DER key material, cached by it's SHA-256 - so it never touches the filesystem.
+ *
+ * @param a_material
+ * @param a_type
+ * @param o_status
+ *
+ * @return See \link Get \link.
+ */
+EVP_PKEY* pg::cpp::utils::KeyCache::GetMemory (const std::string& a_material, const pg::cpp::utils::KeyCache::Type a_type, pg::cpp::utils::Status& o_status)
+{
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int  digest_len = 0;
+    if ( 1 != EVP_Digest(a_material.data(), a_material.length(), digest, &digest_len, EVP_sha256(), NULL) ) {
+        ERR_clear_error();
+        o_status.Fail("Error while calculating key material digest!");
+        return nullptr;
+    }
+
+    const std::string key = ( Type::Private == a_type ? "private:sha256:" : "public:sha256:" )
+                          + std::string(reinterpret_cast<const char*>(digest), digest_len);
+
+    const Entry* entry = s_cache_.Find(key);
+    if ( nullptr != entry ) {
+        return entry->pkey_.get();
+    }
+
+    BIO* bio = BIO_new_mem_buf(const_cast<char*>(a_material.data()), static_cast<int>(a_material.length()));
+    if ( nullptr == bio ) {
+        ERR_clear_error();
+        o_status.Fail("Error while allocating key material BIO!");
+        return nullptr;
+    }
+    EVP_PKEY* pkey = Load(bio, /* a_pem */ 0 == a_material.compare(0, 10, "-----BEGIN"), a_type);
+    BIO_free(bio);
+    if ( nullptr == pkey ) {
+        o_status.Fail("Error while loading %s key from %zd bytes of key material!", Type::Private == a_type ? "private" : "public", a_material.length());
+        return nullptr;
+    }
+
+    return Insert(key, pkey, 0, 0);
+}
+
+/**
+ * @brief Parse a key.
+ *
+ * @param a_bio
+ * @param a_pem  True if PEM encoded, false if DER.
+ * @param a_type
+ *
+ * @return Parsed key, nullptr on failure.
+ */
+EVP_PKEY* pg::cpp::utils::KeyCache::Load (BIO* a_bio, const bool a_pem, const pg::cpp::utils::KeyCache::Type a_type)
+{
+    EVP_PKEY* pkey = nullptr;
+    if ( Type::Private == a_type ) {
+        pkey = ( a_pem ? PEM_read_bio_PrivateKey(a_bio, NULL, NULL, NULL) : d2i_PrivateKey_bio(a_bio, NULL) );
+    } else {
+        pkey = ( a_pem ? PEM_read_bio_PUBKEY(a_bio, NULL, NULL, NULL) : d2i_PUBKEY_bio(a_bio, NULL) );
+        if ( nullptr == pkey ) {
+            // ... not a PUBLIC KEY, try a CERTIFICATE ...
+            (void)BIO_reset(a_bio);
+            X509* x509 = ( a_pem ? PEM_read_bio_X509(a_bio, NULL, NULL, NULL) : d2i_X509_bio(a_bio, NULL) );
+            if ( nullptr != x509 ) {
+                pkey = X509_get_pubkey(x509);
+                X509_free(x509);
+            }
+        }
+    }
+    ERR_clear_error();
+    return pkey;
+}
+
+/**
+ * @brief Keep a parsed key.
+ *
+ * @remarks It's size is estimated as 8 numbers of the key's size - an RSA private key's components plus the
+ *          Montgomery contexts OpenSSL computes on first use.
+ *
+ * @param a_key   Cache key.
+ * @param a_pkey  Parsed key, now owned by the cache.
+ * @param a_mtime File only.
+ * @param a_size  File only.
+ *
+ * @return \p a_pkey.
+ */
+EVP_PKEY* pg::cpp::utils::KeyCache::Insert (const std::string& a_key, EVP_PKEY* a_pkey, const time_t a_mtime, const off_t a_size)
+{
+    const size_t bytes = a_key.length() + static_cast<size_t>(EVP_PKEY_bits(a_pkey));
+    return s_cache_.Insert(a_key, Entry { PKey(a_pkey, EVP_PKEY_free), a_mtime, a_size }, bytes).pkey_.get();
+}
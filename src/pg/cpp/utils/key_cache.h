@@ -0,0 +1,105 @@
+/**
+ * @file key_cache.h
+ *
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef PG_CPP_UTILS_KEY_CACHE_H_
+#define PG_CPP_UTILS_KEY_CACHE_H_
+
+#include <openssl/evp.h>
+#include <openssl/bio.h>
+
+#include <stdint.h>    // uint8_t
+#include <sys/types.h> // off_t
+#include <time.h>      // time_t
+
+#include <string> // std::string
+#include <memory> // std::unique_ptr
+
+#include "pg/cpp/utils/cache.h"
+#include "pg/cpp/utils/status.h"
+
+namespace pg
+{
+
+    namespace cpp
+    {
+
+        namespace utils
+        {
+
+            /**
+             * @brief Backend wide cache of parsed PEM keys, so signing and verifying do not re-read and re-parse them per call.
+             *
+             * @remarks Bounded by the \link Cache \link memory budget, keys must not be kept across calls.
+             */
+            class KeyCache final
+            {
+
+            public: // Data Type(s)
+
+                enum class Type : uint8_t
+                {
+                    Private = 0,
+                    Public
+                };
+
+                enum class Source : uint8_t
+                {
+                    File = 0, // PEM file path
+                    Memory    // PEM or DER key material, e.g. from a table
+                };
+
+            private: // Data Type(s)
+
+                typedef std::unique_ptr<EVP_PKEY, void (*)(EVP_PKEY*)> PKey;
+
+                typedef struct {
+                    PKey   pkey_;
+                    time_t mtime_; // File only
+                    off_t  size_;  // File only
+                } Entry;
+
+            private: // Static Data
+
+                static LRUCache<std::string, Entry> s_cache_;
+
+            public: // Static Method(s) / Function(s)
+
+                static EVP_PKEY* Get   (const std::string& a_key, const Type a_type, const Source a_source, Status& o_status);
+                static void      Reset ();
+
+            private: // Static Method(s) / Function(s)
+
+                static EVP_PKEY* GetFile   (const std::string& a_uri, const Type a_type, Status& o_status);
+                static EVP_PKEY* GetMemory (const std::string& a_material, const Type a_type, Status& o_status);
+                static EVP_PKEY* Load      (BIO* a_bio, const bool a_pem, const Type a_type);
+                static EVP_PKEY* Insert    (const std::string& a_key, EVP_PKEY* a_pkey, const time_t a_mtime, const off_t a_size);
+
+            }; // end of class 'KeyCache'
+
+        } // end of namespace 'utils'
+
+    } // end of namespace 'cpp'
+
+} // end of namespace 'pg'
+
+#endif // PG_CPP_UTILS_KEY_CACHE_H_
@@ -0,0 +1,223 @@
+/**
+ * @file locale_registry.cc
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pg/cpp/utils/locale_registry.h"
+
+#include "pg/cpp/utils/exception.h"
+
+#include <unicode/uloc.h> // uloc_forLanguageTag
+
+#include <string.h> // strchr, memcpy
+
+std::map<std::string, pg::cpp::utils::LocaleRegistry::Id>                                                                                                                                     pg::cpp::utils::LocaleRegistry::s_ids_;
+std::vector<pg::cpp::utils::LocaleRegistry::Entry*>                                                                                                                                           pg::cpp::utils::LocaleRegistry::s_entries_;
+pg::cpp::utils::LRUCache<pg::cpp::utils::LocaleRegistry::Id, pg::cpp::utils::LocaleRegistry::Symbols, std::hash<pg::cpp::utils::LocaleRegistry::Id>, pg::cpp::utils::LocaleRegistry::Release> pg::cpp::utils::LocaleRegistry::s_symbols_("locales");
+
+/**
+ * @brief Resolved locale data left the cache, it's entry is resolved again when next used.
+ *
+ * @param a_id
+ * @param a_symbols
+ */
+void pg::cpp::utils::LocaleRegistry::Release::operator() (const pg::cpp::utils::LocaleRegistry::Id& a_id, pg::cpp::utils::LocaleRegistry::Symbols& /* a_symbols */) const
+{
+    s_entries_[a_id]->symbols_ = nullptr;
+}
+
+/**
+ * @brief Obtain the id of a locale, canonicalizing it's name only the first time it's seen.
+ *
+ * @param a_locale ICU ( pt_PT ) or BCP-47 ( pt-PT ) locale name.
+ *
+ * @return Id shared by all spellings of the same locale.
+ *
+ * @throw
+ */
+pg::cpp::utils::LocaleRegistry::Id pg::cpp::utils::LocaleRegistry::Intern (const pg::cpp::utils::StringView& a_locale)
+{
+    pg::cpp::utils::Status status;
+    Id                     id = 0;
+    if ( false == Intern(a_locale, id, status) ) {
+        throw PG_CPP_UTILS_EXCEPTION("%s", status.Message().c_str());
+    }
+    return id;
+}
+
+/**
+ * @brief Obtain a resolved locale, resolving it only once per backend - unless evicted.
+ *
+ * @param a_id See \link Intern \link.
+ *
+ * @return Entry owned by the registry, it's symbols_ are valid until another cache entry is inserted.
+ *
+ * @throw
+ */
+const pg::cpp::utils::LocaleRegistry::Entry& pg::cpp::utils::LocaleRegistry::Get (const pg::cpp::utils::LocaleRegistry::Id a_id)
+{
+    pg::cpp::utils::Status status;
+    const Entry* entry = Resolve(a_id, status);
+    if ( nullptr == entry ) {
+        throw PG_CPP_UTILS_EXCEPTION("%s", status.Message().c_str());
+    }
+    return *entry;
+}
+
+/**
+ * @brief Obtain a resolved locale by name, see \link Intern \link.
+ *
+ * @param a_locale
+ *
+ * @throw
+ */
+const pg::cpp::utils::LocaleRegistry::Entry& pg::cpp::utils::LocaleRegistry::Get (const pg::cpp::utils::StringView& a_locale)
+{
+    return Get(Intern(a_locale));
+}
+
+/**
+ * @brief Obtain a resolved locale by name without throwing, for the utilities hot path.
+ *
+ * @param a_locale
+ * @param o_status Set to failed when \p a_locale can't be used.
+ *
+ * @return The requested locale's entry or, on failure, the root locale's one - so callers can still be constructed
+ *         and report \p o_status instead.
+ *
+ * @throw Only when not even the root locale can be resolved.
+ */
+const pg::cpp::utils::LocaleRegistry::Entry& pg::cpp::utils::LocaleRegistry::Get (const pg::cpp::utils::StringView& a_locale, pg::cpp::utils::Status& o_status)
+{
+    Id id = 0;
+    if ( true == Intern(a_locale, id, o_status) ) {
+        const Entry* entry = Resolve(id, o_status);
+        if ( nullptr != entry ) {
+            return *entry;
+        }
+    }
+    return Get(StringView("root"));
+}
+
+/**
+ * @brief Obtain the id of a locale, see \link Intern \link.
+ *
+ * @param a_locale
+ * @param o_id
+ * @param o_status
+ *
+ * @return False, with \p o_status set, when the locale is not valid.
+ */
+bool pg::cpp::utils::LocaleRegistry::Intern (const pg::cpp::utils::StringView& a_locale, pg::cpp::utils::LocaleRegistry::Id& o_id, pg::cpp::utils::Status& o_status)
+{
+    const std::string key = a_locale.ToString();
+
+    const auto it = s_ids_.find(key);
+    if ( s_ids_.end() != it ) {
+        o_id = it->second;
+        return true;
+    }
+
+    char locale[ULOC_FULLNAME_CAPACITY];
+    (void)a_locale.CopyTo(locale, sizeof(locale));
+
+    // ... BCP-47 tags ( pt-PT, en-US-u-nu-latn ) are converted to ICU locale ids first ...
+    if ( nullptr != strchr(locale, '-') ) {
+        char       tag[ULOC_FULLNAME_CAPACITY];
+        UErrorCode icu_error_code = U_ZERO_ERROR;
+        memcpy(tag, locale, sizeof(tag));
+        const int32_t length = uloc_forLanguageTag(tag, locale, static_cast<int32_t>(sizeof(locale)), nullptr, &icu_error_code);
+        if ( U_FAILURE(icu_error_code) || U_STRING_NOT_TERMINATED_WARNING == icu_error_code || 0 == length ) {
+            memcpy(locale, tag, sizeof(locale));
+        }
+    }
+
+    const U_ICU_NAMESPACE::Locale icu_locale = U_ICU_NAMESPACE::Locale::createFromName(locale);
+    if ( true == icu_locale.isBogus() ) {
+        return o_status.Fail("Locale '%.*s' is not valid", static_cast<int>(a_locale.Length()), a_locale.Data());
+    }
+
+    const std::string name = icu_locale.getName();
+
+    Id id;
+    const auto canonical = s_ids_.find(name);
+    if ( s_ids_.end() != canonical ) {
+        id = canonical->second;
+    } else {
+        if ( s_entries_.size() > static_cast<size_t>(UINT16_MAX) ) {
+            return o_status.Fail("Too many distinct locales, unable to register '%.*s'", static_cast<int>(a_locale.Length()), a_locale.Data());
+        }
+        id = static_cast<Id>(s_entries_.size());
+        Entry* entry    = new Entry();
+        entry->id_      = id;
+        entry->name_    = name;
+        entry->locale_  = icu_locale;
+        entry->symbols_ = nullptr;
+        s_entries_.push_back(entry);
+        s_ids_[name] = id;
+    }
+    s_ids_[key] = id;
+
+    o_id = id;
+
+    return true;
+}
+
+/**
+ * @brief Obtain a resolved locale, see \link Get \link.
+ *
+ * @param a_id
+ * @param o_status
+ *
+ * @return Entry owned by the registry, nullptr with \p o_status set when the locale is not supported.
+ */
+const pg::cpp::utils::LocaleRegistry::Entry* pg::cpp::utils::LocaleRegistry::Resolve (const pg::cpp::utils::LocaleRegistry::Id a_id, pg::cpp::utils::Status& o_status)
+{
+    if ( static_cast<size_t>(a_id) >= s_entries_.size() ) {
+        o_status.Fail("Locale id %u is not registered", static_cast<unsigned>(a_id));
+        return nullptr;
+    }
+
+    Entry* entry = s_entries_[a_id];
+    if ( nullptr != s_symbols_.Find(a_id) ) {
+        return entry;
+    }
+
+    UErrorCode icu_error_code = U_ZERO_ERROR;
+
+    U_ICU_NAMESPACE::DecimalFormatSymbols* symbols = new U_ICU_NAMESPACE::DecimalFormatSymbols(entry->locale_, icu_error_code);
+    if ( U_FAILURE(icu_error_code) ) {
+        delete symbols;
+        o_status.Fail("Locale '%s' is not supported: %s", entry->name_.c_str(), u_errorName(icu_error_code));
+        return nullptr;
+    }
+    entry->symbols_ = s_symbols_.Insert(a_id, Symbols(symbols), sizeof(U_ICU_NAMESPACE::DecimalFormatSymbols)).get();
+
+    return entry;
+}
+
+/**
+ * @brief Release all resolved locale data, ids remain valid.
+ *
+ * @remarks Must be called before u_cleanup, ICU objects can not outlive it.
+ */
+void pg::cpp::utils::LocaleRegistry::Reset ()
+{
+    (void)s_symbols_.Clear();
+}
@@ -0,0 +1,105 @@
+/**
+ * @file locale_registry.h
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef PG_CPP_UTILS_LOCALE_REGISTRY_H_
+#define PG_CPP_UTILS_LOCALE_REGISTRY_H_
+
+#include "pg/cpp/utils/string_view.h"
+#include "pg/cpp/utils/status.h"
+#include "pg/cpp/utils/cache.h"
+
+#include <stdint.h> // uint16_t
+
+#include <string> // std::string
+#include <vector> // std::vector
+#include <map>    // std::map
+#include <memory> // std::unique_ptr
+
+#include <unicode/locid.h>    // ICU Locale
+#include <unicode/dcfmtsym.h> // ICU DecimalFormatSymbols
+
+namespace pg
+{
+
+    namespace cpp
+    {
+
+        namespace utils
+        {
+
+            /**
+             * @brief Backend wide registry of resolved locales, so formatters do not look up ICU locale data per call.
+             *
+             * @remarks Locale names are interned: BCP-47 ( pt-PT ) and ICU ( pt_PT ) spellings of the same locale share
+             *          one compact \link Id \link, stable for the backend's life, that caches and overrides can key on.
+             */
+            class LocaleRegistry final
+            {
+
+            public: // Data Type(s)
+
+                typedef uint16_t Id;
+
+                typedef struct {
+                    Id                                     id_;
+                    std::string                            name_;    // canonical ICU name
+                    U_ICU_NAMESPACE::Locale                locale_;
+                    U_ICU_NAMESPACE::DecimalFormatSymbols* symbols_; // nullptr until resolved, owned by s_symbols_
+                } Entry;
+
+            private: // Data Type(s)
+
+                typedef std::unique_ptr<U_ICU_NAMESPACE::DecimalFormatSymbols> Symbols;
+
+                struct Release
+                {
+                    void operator() (const Id& a_id, Symbols& a_symbols) const;
+                };
+
+            private: // Static Data
+
+                static std::map<std::string, Id>                     s_ids_;     // by name, as received and canonical
+                static std::vector<Entry*>                           s_entries_; // by id
+                static LRUCache<Id, Symbols, std::hash<Id>, Release> s_symbols_; // resolved locale data
+
+            public: // Static Method(s) / Function(s)
+
+                static Id           Intern (const StringView& a_locale);
+                static const Entry& Get    (const Id a_id);
+                static const Entry& Get    (const StringView& a_locale);
+                static const Entry& Get    (const StringView& a_locale, Status& o_status);
+                static void         Reset  ();
+
+            private: // Static Method(s) / Function(s)
+
+                static bool         Intern  (const StringView& a_locale, Id& o_id, Status& o_status);
+                static const Entry* Resolve (const Id a_id, Status& o_status);
+
+            }; // end of class 'LocaleRegistry'
+
+        } // end of namespace 'utils'
+
+    } // end of namespace 'cpp'
+
+} // end of namespace 'pg'
+
+#endif // PG_CPP_UTILS_LOCALE_REGISTRY_H_
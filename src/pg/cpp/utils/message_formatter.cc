@@ -24,14 +24,19 @@
 #include "pg/cpp/utils/exception.h"
 
 #include "unicode/msgfmt.h"
+#include "unicode/timezone.h"
+
+#include <memory> // std::unique_ptr
 
 /**
  * @brief Default constructor.
  *
+ * @remarks An unusable locale is not thrown, check \link LastStatus \link before formatting.
+ *
  * @param a_locale
  */
-pg::cpp::utils::MessageFormatter::MessageFormatter (const std::string& a_locale)
-    : icu_locale_(U_ICU_NAMESPACE::Locale::createFromName(a_locale.c_str())),
+pg::cpp::utils::MessageFormatter::MessageFormatter (const pg::cpp::utils::StringView& a_locale)
+    : locale_(pg::cpp::utils::LocaleRegistry::Get(a_locale, status_)),
       icu_error_code_(UErrorCode::U_ZERO_ERROR)
 {
     /* empty */
@@ -52,8 +57,8 @@ pg::cpp::utils::MessageFormatter::~MessageFormatter ()
  */
 void pg::cpp::utils::MessageFormatter::FillOutputAtUserFuncContext (FuncCallContext* a_context)
 {
-    Utility::Records* records = static_cast<Utility::Records*>(a_context->user_fctx);
-    records->Append(new pg::cpp::utils::MessageFormatter::Record(string_));
+    Utility::Records* records = Utility::UserFuncContextRecords(a_context);
+    records->Append(1)[0] = records->Copy(string_);
     a_context->max_calls += 1;
 }
 
@@ -65,39 +70,208 @@ void pg::cpp::utils::MessageFormatter::FillOutputAtUserFuncContext (FuncCallCont
  *
  * @throw
  */
-void pg::cpp::utils::MessageFormatter::Format (const std::string& a_format, const std::vector<std::string>& a_args)
+void pg::cpp::utils::MessageFormatter::Format (const pg::cpp::utils::StringView& a_format, const std::vector<pg::cpp::utils::StringView>& a_args)
 {
     string_ = "";
-    error_  = "";
+    status_.Reset();
 
     if ( 0 == a_args.size() ) {
-        string_ = a_format;
+        string_.assign(a_format.Data(), a_format.Length());
         return;
     }
 
     if ( not ( U_ZERO_ERROR == icu_error_code_ || U_USING_DEFAULT_WARNING == icu_error_code_ ) ) {
-        error_ = std::to_string(icu_error_code_);
+        status_.Fail("error code %d", icu_error_code_);
+        return;
+    }
+
+    // ... plain {n} substitutions don't need ICU ...
+    if ( true == FormatSimple(a_format, a_args) ) {
         return;
     }
 
     U_ICU_NAMESPACE::UnicodeString unicode_string;
 
-    U_ICU_NAMESPACE::Formattable* args = new U_ICU_NAMESPACE::Formattable[a_args.size()];
+    std::vector<U_ICU_NAMESPACE::Formattable> args(a_args.size());
     for ( size_t idx = 0 ; idx < a_args.size() ; ++idx ) {
-        args[idx] = U_ICU_NAMESPACE::Formattable(a_args[idx].c_str());
+        args[idx].adoptString(new U_ICU_NAMESPACE::UnicodeString(
+            U_ICU_NAMESPACE::UnicodeString::fromUTF8(U_ICU_NAMESPACE::StringPiece(a_args[idx].Data(), static_cast<int32_t>(a_args[idx].Length()))))
+        );
     }
 
-    U_ICU_NAMESPACE::MessageFormat::format(a_format.c_str(),
-        args, a_args.size(),
+    U_ICU_NAMESPACE::MessageFormat::format(U_ICU_NAMESPACE::UnicodeString::fromUTF8(U_ICU_NAMESPACE::StringPiece(a_format.Data(), static_cast<int32_t>(a_format.Length()))),
+        args.data(), static_cast<int32_t>(args.size()),
         unicode_string, icu_error_code_
     );
 
-    delete [] args;
+    if ( not ( U_ZERO_ERROR == icu_error_code_ || U_USING_DEFAULT_WARNING == icu_error_code_ ) ) {
+        status_.Fail("error code %d", icu_error_code_);
+        return;
+    }
+
+    unicode_string.toUTF8String(string_);
+}
+
+/**
+ * @brief Format a message with typed arguments, so numbers and dates reach ICU as such.
+ *
+ * @remarks Date arguments are wall clock times, rendered as is in whatever zone ICU formats dates.
+ *
+ * @param a_format
+ * @param a_args
+ *
+ * @throw
+ */
+void pg::cpp::utils::MessageFormatter::FormatTyped (const pg::cpp::utils::StringView& a_format, const std::vector<pg::cpp::utils::MessageFormatter::Argument>& a_args)
+{
+    // ... only strings? take the text path, it may skip ICU ...
+    bool strings_only = true;
+    for ( auto& arg : a_args ) {
+        if ( ArgumentType::String != arg.type_ ) {
+            strings_only = false;
+            break;
+        }
+    }
+    if ( true == strings_only ) {
+        std::vector<StringView> args;
+        args.reserve(a_args.size());
+        for ( auto& arg : a_args ) {
+            args.push_back(arg.string_);
+        }
+        Format(a_format, args);
+        return;
+    }
+
+    string_ = "";
+    status_.Reset();
 
     if ( not ( U_ZERO_ERROR == icu_error_code_ || U_USING_DEFAULT_WARNING == icu_error_code_ ) ) {
-        error_ = std::to_string(icu_error_code_);
+        status_.Fail("error code %d", icu_error_code_);
+        return;
+    }
+
+    std::unique_ptr<U_ICU_NAMESPACE::TimeZone> time_zone;
+
+    std::vector<U_ICU_NAMESPACE::Formattable> args(a_args.size());
+    for ( size_t idx = 0 ; idx < a_args.size() && U_SUCCESS(icu_error_code_) ; ++idx ) {
+        const Argument& arg = a_args[idx];
+        switch ( arg.type_ ) {
+            case ArgumentType::Int64:
+                args[idx].setInt64(arg.int64_);
+                break;
+            case ArgumentType::Double:
+                args[idx].setDouble(arg.double_);
+                break;
+            case ArgumentType::Decimal:
+                args[idx].setDecimalNumber(U_ICU_NAMESPACE::StringPiece(arg.string_.Data(), static_cast<int32_t>(arg.string_.Length())), icu_error_code_);
+                break;
+            case ArgumentType::Date:
+            {
+                // ... shift the wall clock time by ICU's zone offset at that time, so it's rendered unchanged ...
+                if ( nullptr == time_zone.get() ) {
+                    time_zone.reset(U_ICU_NAMESPACE::TimeZone::createDefault());
+                }
+                int32_t raw_offset = 0;
+                int32_t dst_offset = 0;
+                time_zone->getOffset(arg.double_, /* local */ true, raw_offset, dst_offset, icu_error_code_);
+                args[idx].setDate(arg.double_ - static_cast<UDate>(raw_offset + dst_offset));
+                break;
+            }
+            default:
+                args[idx].adoptString(new U_ICU_NAMESPACE::UnicodeString(
+                    U_ICU_NAMESPACE::UnicodeString::fromUTF8(U_ICU_NAMESPACE::StringPiece(arg.string_.Data(), static_cast<int32_t>(arg.string_.Length()))))
+                );
+                break;
+        }
+    }
+
+    if ( not ( U_ZERO_ERROR == icu_error_code_ || U_USING_DEFAULT_WARNING == icu_error_code_ ) ) {
+        status_.Fail("error code %d", icu_error_code_);
+        return;
+    }
+
+    // ... numbers, plurals and dates are locale sensitive, so format with the requested locale ...
+    // ... a formatter reused with the same pattern, e.g. by a call site, skips compiling it again ...
+    if ( nullptr == icu_message_format_ || 0 != icu_message_pattern_.compare(0, std::string::npos, a_format.Data(), a_format.Length()) ) {
+        icu_message_format_.reset(new U_ICU_NAMESPACE::MessageFormat(
+            U_ICU_NAMESPACE::UnicodeString::fromUTF8(U_ICU_NAMESPACE::StringPiece(a_format.Data(), static_cast<int32_t>(a_format.Length()))),
+            locale_.locale_, icu_error_code_
+        ));
+        icu_message_pattern_.assign(a_format.Data(), a_format.Length());
+    }
+
+    U_ICU_NAMESPACE::UnicodeString unicode_string;
+    U_ICU_NAMESPACE::FieldPosition field_position;
+    if ( U_SUCCESS(icu_error_code_) ) {
+        icu_message_format_->format(args.data(), static_cast<int32_t>(args.size()), unicode_string, field_position, icu_error_code_);
+    }
+
+    if ( not ( U_ZERO_ERROR == icu_error_code_ || U_USING_DEFAULT_WARNING == icu_error_code_ ) ) {
+        status_.Fail("error code %d", icu_error_code_);
         return;
     }
 
     unicode_string.toUTF8String(string_);
 }
+
+/**
+ * @brief Format a message made only of literal text and simple {n} arguments, by direct UTF-8 substitution.
+ *
+ * @remarks Anything else - apostrophe quoting, named, typed ( number, plural, select, ... ) or out of range
+ *          arguments, unbalanced braces - is left to ICU, so the output is always the same as MessageFormat's.
+ *
+ * @param a_format
+ * @param a_args
+ *
+ * @return False, with nothing formatted, if the message is not simple.
+ */
+bool pg::cpp::utils::MessageFormatter::FormatSimple (const pg::cpp::utils::StringView& a_format, const std::vector<pg::cpp::utils::StringView>& a_args)
+{
+    const char* const format = a_format.Data();
+    const size_t      length = a_format.Length();
+
+    // ... 1st pass: validate and measure ...
+    size_t output_length = 0;
+    for ( size_t idx = 0 ; idx < length ; ++idx ) {
+        const char c = format[idx];
+        if ( '\'' == c || '}' == c ) {
+            return false;
+        }
+        if ( '{' != c ) {
+            output_length += 1;
+            continue;
+        }
+        size_t end    = idx + 1;
+        size_t number = 0;
+        while ( end < length && format[end] >= '0' && format[end] <= '9' && number < a_args.size() ) {
+            number = number * 10 + static_cast<size_t>(format[end] - '0');
+            ++end;
+        }
+        const size_t digits = end - idx - 1;
+        if ( 0 == digits || end >= length || '}' != format[end] || number >= a_args.size() || ( digits > 1 && '0' == format[idx + 1] ) ) {
+            return false;
+        }
+        output_length += a_args[number].Length();
+        idx = end;
+    }
+
+    // ... 2nd pass: substitute ...
+    string_.clear();
+    string_.reserve(output_length);
+    size_t literal = 0;
+    for ( size_t idx = 0 ; idx < length ; ++idx ) {
+        if ( '{' != format[idx] ) {
+            continue;
+        }
+        string_.append(format + literal, idx - literal);
+        size_t number = 0;
+        for ( ++idx ; '}' != format[idx] ; ++idx ) {
+            number = number * 10 + static_cast<size_t>(format[idx] - '0');
+        }
+        string_.append(a_args[number].Data(), a_args[number].Length());
+        literal = idx + 1;
+    }
+    string_.append(format + literal, length - literal);
+
+    return true;
+}
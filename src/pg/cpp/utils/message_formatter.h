@@ -24,12 +24,17 @@
 #define PG_CPP_UTILS_MESSAGE_FORMATTER_H_
 
 #include "pg/cpp/utils/utility.h"
+#include "pg/cpp/utils/string_view.h"
+#include "pg/cpp/utils/locale_registry.h"
 
 #include <string> // std::string
+#include <vector> // std::vector
+#include <memory> // std::unique_ptr
+#include <stdint.h> // int64_t
 
 #include "unicode/unistr.h"
 #include "unicode/utypes.h"
-#include <unicode/locid.h> // ICU Locale
+#include "unicode/msgfmt.h"
 
 namespace pg
 {
@@ -45,73 +50,33 @@ namespace pg
 
             public: // Data Type(s)
 
-                class Record final : public Utility::Record
+                enum class ArgumentType : uint8_t
                 {
-
-                public: // Const Data
-
-                    const std::string string_;
-
-                private: // Data
-
-                    char** p_string_values_;
-
-                public: // Constructor / Destructor
-
-                    /**
-                     * @brief Default constructor.
-                     *
-                     * @param a_string
-                     */
-                    Record (const std::string& a_string)
-                    : string_(a_string)
-                    {
-                        p_string_values_ = nullptr;
-                    }
-
-                    /**
-                     * @brief Destructor.
-                     */
-                    virtual ~Record ()
-                    {
-                        if ( nullptr != p_string_values_ ) {
-                            if ( nullptr != p_string_values_[0] ) {
-                                pfree(p_string_values_[0]);
-                            }
-                            pfree(p_string_values_);
-                        }
-                    }
-
-                public: // Inherited Pure Virtual Method(s) / Function(s) - implementation
-
-                    /**
-                     * @brief Allocate memory from postgres pool and copy a record data to it.
-                     *
-                     * @return An array of string representing a record.
-                     */
-                    virtual char** PStringValues ()
-                    {
-                        char** tmp = (char**)palloc(sizeof(char*)*1);
-                        if ( nullptr == tmp ) {
-                            return nullptr;
-                        }
-
-                        tmp[0] = PCopyString(string_.c_str());
-
-                        return tmp;
-                    }
-
-                }; // end of 'Record' class
+                    String = 0,
+                    Int64,
+                    Double,
+                    Decimal, // numeric, as it's text representation
+                    Date     // wall clock milliseconds since 1970-01-01 00:00:00
+                };
+
+                typedef struct {
+                    ArgumentType type_;
+                    StringView   string_; // String, Decimal
+                    int64_t      int64_;  // Int64
+                    double       double_; // Double, Date
+                } Argument;
 
             protected: // Data
 
-                U_ICU_NAMESPACE::Locale icu_locale_;
-                UErrorCode              icu_error_code_;
-                std::string             string_;
+                const LocaleRegistry::Entry&                    locale_;
+                UErrorCode                                      icu_error_code_;
+                std::string                                     string_;
+                std::unique_ptr<U_ICU_NAMESPACE::MessageFormat> icu_message_format_; // FormatTyped's last compiled pattern
+                std::string                                     icu_message_pattern_;
 
             public: // Constructor / Destructor.
 
-                MessageFormatter (const std::string& a_locale);
+                MessageFormatter (const StringView& a_locale);
                 virtual ~MessageFormatter();
 
             public: // Inherited Pure Virtual Method(s) / Function(s)
@@ -120,7 +85,12 @@ namespace pg
 
             public: // Method(s) / Function(s)
 
-                void Format (const std::string& a_format, const std::vector<std::string>& a_args);
+                void Format      (const StringView& a_format, const std::vector<StringView>& a_args);
+                void FormatTyped (const StringView& a_format, const std::vector<Argument>& a_args);
+
+            protected: // Method(s) / Function(s)
+
+                bool FormatSimple (const StringView& a_format, const std::vector<StringView>& a_args);
 
             }; // end of class 'NumberSpellout
 
@@ -26,24 +26,28 @@
 /**
  * @brief Default constructor.
  *
+ * @remarks Failures are not thrown, check \link LastStatus \link before formatting.
+ *
  * @param a_locale
  */
-pg::cpp::utils::NumberFormatter::NumberFormatter (const std::string& a_locale)
-    : pg::cpp::utils::MessageFormatter(a_locale.c_str()),
-      icu_number_format_(icu_error_code_)
+pg::cpp::utils::NumberFormatter::NumberFormatter (const pg::cpp::utils::StringView& a_locale)
+    : pg::cpp::utils::MessageFormatter(a_locale),
+      icu_number_format_(U_ICU_NAMESPACE::UnicodeString("#"), *locale_.symbols_, icu_error_code_)
 {
     icu_number_format_.setRoundingMode(U_ICU_NAMESPACE::DecimalFormat::kRoundUp); // Unnecessary);
 
-    U_ICU_NAMESPACE::DecimalFormatSymbols symbols(icu_locale_, icu_error_code_);
-    if ( U_ZERO_ERROR == icu_error_code_ || U_USING_FALLBACK_WARNING == icu_error_code_ || U_USING_DEFAULT_WARNING == icu_error_code_ ) {
-        if ( a_locale == "pt_PT" || a_locale == "pt-PT" ) {
-	  symbols.setSymbol(U_ICU_NAMESPACE::DecimalFormatSymbols::kGroupingSeparatorSymbol, ".", true);
-        }
+    // ... pt_PT groups with '.' ( any spelling of it, e.g. pt-PT ) ...
+    static const pg::cpp::utils::LocaleRegistry::Id k_pt_PT_ = pg::cpp::utils::LocaleRegistry::Intern("pt_PT");
+    if ( k_pt_PT_ == locale_.id_ ) {
+        U_ICU_NAMESPACE::DecimalFormatSymbols symbols(*locale_.symbols_);
+        symbols.setSymbol(U_ICU_NAMESPACE::DecimalFormatSymbols::kGroupingSeparatorSymbol, ".", true);
         icu_number_format_.setDecimalFormatSymbols(symbols);
-        icu_error_code_ = U_ZERO_ERROR;
-    } else {
-        throw PG_CPP_UTILS_EXCEPTION("Locale '%s' is not supported", a_locale.c_str());
     }
+    if ( U_FAILURE(icu_error_code_) ) {
+        status_.Fail("Locale '%.*s' is not supported", static_cast<int>(a_locale.Length()), a_locale.Data());
+        return;
+    }
+    icu_error_code_ = U_ZERO_ERROR;
 }
 
 /**
@@ -62,20 +66,25 @@ pg::cpp::utils::NumberFormatter::~NumberFormatter ()
  *
  * @throw
  */
-void pg::cpp::utils::NumberFormatter::Format (double a_number, const std::string& a_pattern)
+void pg::cpp::utils::NumberFormatter::Format (double a_number, const pg::cpp::utils::StringView& a_pattern)
 {
     string_ = "";
-    error_  = "";
+    status_.Reset();
 
     if ( not ( U_ZERO_ERROR == icu_error_code_ || U_USING_DEFAULT_WARNING == icu_error_code_ ) ) {
-        error_ = std::to_string(icu_error_code_);
+        status_.Fail("error code %d", icu_error_code_);
         return;
     }
 
-    icu_number_format_.applyPattern(U_ICU_NAMESPACE::UnicodeString::fromUTF8(a_pattern), icu_error_code_);
-    if ( not ( U_ZERO_ERROR == icu_error_code_ || U_USING_DEFAULT_WARNING == icu_error_code_ ) ) {
-        error_ = std::to_string(icu_error_code_);
-        return;
+    // ... a formatter reused with the same pattern, e.g. by a call site, skips parsing it again ...
+    if ( 0 != pattern_.compare(0, std::string::npos, a_pattern.Data(), a_pattern.Length()) ) {
+        pattern_.clear();
+        icu_number_format_.applyPattern(U_ICU_NAMESPACE::UnicodeString::fromUTF8(U_ICU_NAMESPACE::StringPiece(a_pattern.Data(), static_cast<int32_t>(a_pattern.Length()))), icu_error_code_);
+        if ( not ( U_ZERO_ERROR == icu_error_code_ || U_USING_DEFAULT_WARNING == icu_error_code_ ) ) {
+            status_.Fail("error code %d", icu_error_code_);
+            return;
+        }
+        pattern_.assign(a_pattern.Data(), a_pattern.Length());
     }
 
     U_ICU_NAMESPACE::UnicodeString unicode_string;
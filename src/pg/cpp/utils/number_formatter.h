@@ -43,15 +43,16 @@ namespace pg
             private: // Data
 
                 U_ICU_NAMESPACE::DecimalFormat icu_number_format_;
+                std::string                    pattern_; // last applied pattern
 
             public: // Constructor / Destructor.
 
-                NumberFormatter (const std::string& a_locale);
+                NumberFormatter (const StringView& a_locale);
                 virtual ~NumberFormatter();
 
             public: // Method(s) / Function(s)
 
-                void Format (double a_number, const std::string& a_pattern);
+                void Format (double a_number, const StringView& a_pattern);
 
             }; // end of class 'NumberSpellout
 
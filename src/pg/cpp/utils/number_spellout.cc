@@ -34,18 +34,62 @@
  * @brief Default constructor.
  *
  * @param a_locale
+ * @param a_spellout_override Rule set to use instead of the locale's spellout rules, empty for none: RBNF text or
+ *                            the name of a loaded \link SpelloutRules \link rule set.
+ * @param a_rule_set          Public rule set to format with ( e.g. %spellout-ordinal-feminine ), empty for the default one.
+ *
+ * @remarks Failures, e.g. \p a_rule_set not being one of the formatter's public rule sets, are not thrown - check
+ *          \link LastStatus \link before spelling out.
  */
-pg::cpp::utils::NumberSpellout::NumberSpellout (const std::string& a_locale, const std::string& a_spellout_override)
-    : icu_locale_(U_ICU_NAMESPACE::Locale::createFromName(a_locale.c_str()))
+pg::cpp::utils::NumberSpellout::NumberSpellout (const pg::cpp::utils::StringView& a_locale, const pg::cpp::utils::StringView& a_spellout_override,
+                                                const pg::cpp::utils::StringView& a_rule_set)
+    : locale_(pg::cpp::utils::LocaleRegistry::Get(a_locale, status_)),
+      memo_id_(0),
+      cursor_(0)
 {
     icu_error_code_ = UErrorCode::U_ZERO_ERROR;
-    if ( 0 == a_spellout_override.length() ) {
-        icu_number_format_ = new U_ICU_NAMESPACE::RuleBasedNumberFormat(U_ICU_NAMESPACE::URBNFRuleSetTag::URBNF_SPELLOUT, icu_locale_, icu_error_code_);
+    if ( true == a_spellout_override.Empty() ) {
+        icu_number_format_ = pg::cpp::utils::SpelloutRules::BuiltIn(locale_, status_);
+    } else if ( true == pg::cpp::utils::SpelloutRules::IsName(a_spellout_override) ) {
+        icu_number_format_ = pg::cpp::utils::SpelloutRules::Get(a_spellout_override, locale_, status_);
     } else {
-        icu_number_format_ = new U_ICU_NAMESPACE::RuleBasedNumberFormat(a_spellout_override.c_str(), icu_locale_, icu_parse_error_, icu_error_code_);
+        icu_number_format_.reset(new U_ICU_NAMESPACE::RuleBasedNumberFormat(
+            U_ICU_NAMESPACE::UnicodeString::fromUTF8(U_ICU_NAMESPACE::StringPiece(a_spellout_override.Data(), static_cast<int32_t>(a_spellout_override.Length()))),
+            locale_.locale_, icu_parse_error_, icu_error_code_
+        ));
+    }
+    // ... unusable locale or rules, Spellout must not use the formatter ...
+    if ( true == status_.Failed() ) {
+        icu_error_code_ = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
     }
     if ( not ( U_ZERO_ERROR == icu_error_code_ || U_USING_DEFAULT_WARNING == icu_error_code_ ) ) {
-      error_ = "ICU version:" + std::string(U_ICU_VERSION) + " - an error occurred while initializing RuleBasedNumberFormat: " + std::to_string(icu_error_code_);
+      status_.Fail("ICU version:%s - an error occurred while initializing RuleBasedNumberFormat: %d", U_ICU_VERSION, icu_error_code_);
+      return;
+    }
+    if ( false == a_rule_set.Empty() ) {
+        // ... formatters may be shared, so the rule set is passed on each format call instead of becoming the default one ...
+        icu_rule_set_ = U_ICU_NAMESPACE::UnicodeString::fromUTF8(U_ICU_NAMESPACE::StringPiece(a_rule_set.Data(), static_cast<int32_t>(a_rule_set.Length())));
+        bool        found = false;
+        std::string available;
+        for ( int32_t idx = 0 ; idx < icu_number_format_->getNumberOfRuleSetNames() && false == found ; ++idx ) {
+            const U_ICU_NAMESPACE::UnicodeString name = icu_number_format_->getRuleSetName(idx);
+            found = ( name == icu_rule_set_ );
+            if ( 0 != idx ) {
+                available += ", ";
+            }
+            name.toUTF8String(available);
+        }
+        if ( false == found ) {
+            icu_error_code_ = U_ILLEGAL_ARGUMENT_ERROR;
+            status_.Fail("Unknown spellout rule set '%.*s' for locale '%s', available: %s",
+                         static_cast<int>(a_rule_set.Length()), a_rule_set.Data(), locale_.name_.c_str(), available.c_str());
+            return;
+        }
+    }
+    // ... only backend cached formatters are memoized, ad-hoc RBNF text lives for a single call ...
+    if ( true == a_spellout_override.Empty() || true == pg::cpp::utils::SpelloutRules::IsName(a_spellout_override) ) {
+        memo_id_ = pg::cpp::utils::SpelloutMemo::Register(icu_number_format_.get(), a_rule_set);
     }
 }
 
@@ -54,7 +98,7 @@ pg::cpp::utils::NumberSpellout::NumberSpellout (const std::string& a_locale, con
  */
 pg::cpp::utils::NumberSpellout::~NumberSpellout ()
 {
-    delete icu_number_format_;
+    /* empty */
 }
 
 /**
@@ -64,11 +108,47 @@ pg::cpp::utils::NumberSpellout::~NumberSpellout ()
  */
 void pg::cpp::utils::NumberSpellout::FillOutputAtUserFuncContext (FuncCallContext* a_context)
 {
-    Utility::Records* records = static_cast<Utility::Records*>(a_context->user_fctx);
-    records->Append(new pg::cpp::utils::NumberSpellout::Record(string_));
+    Utility::Records* records = Utility::UserFuncContextRecords(a_context);
+    records->Append(1)[0] = records->Copy(string_);
     a_context->max_calls += 1;
 }
 
+/**
+ * @brief Spell out the next number of a batch.
+ *
+ * @param a_records
+ *
+ * @return False when the batch is exhausted.
+ */
+bool pg::cpp::utils::NumberSpellout::Next (Utility::Records& a_records)
+{
+    if ( cursor_ >= batch_.size() ) {
+        return false;
+    }
+    const size_t idx = cursor_++;
+    char** values = a_records.Append(2);
+    if ( true == batch_nulls_[idx] ) {
+        return true;
+    }
+    Spellout(batch_[idx]);
+    values[0] = a_records.Format("%.15g", batch_[idx]);
+    values[1] = a_records.Copy(string_);
+    return true;
+}
+
+/**
+ * @brief Prepare a batch of numbers to be spelled out, one per \link Next \link call.
+ *
+ * @param a_numbers
+ * @param a_nulls
+ */
+void pg::cpp::utils::NumberSpellout::SpelloutBatch (const std::vector<double>& a_numbers, const std::vector<bool>& a_nulls)
+{
+    batch_       = a_numbers;
+    batch_nulls_ = a_nulls;
+    cursor_      = 0;
+}
+
 /**
  * @brief Convert a number to words.
  *
@@ -83,11 +163,25 @@ void pg::cpp::utils::NumberSpellout::Spellout (double a_number)
 	return;
     }
     if ( U_ZERO_ERROR == icu_error_code_ || U_USING_DEFAULT_WARNING == icu_error_code_ ) {
+        if ( true == pg::cpp::utils::SpelloutMemo::Get(memo_id_, a_number, string_) ) {
+            return;
+        }
         U_ICU_NAMESPACE::UnicodeString unicode_string;
-        icu_number_format_->format(a_number, unicode_string);
+        if ( true == icu_rule_set_.isEmpty() ) {
+            icu_number_format_->format(a_number, unicode_string);
+        } else {
+            U_ICU_NAMESPACE::FieldPosition field_position;
+            UErrorCode                     error_code = UErrorCode::U_ZERO_ERROR;
+            icu_number_format_->format(a_number, icu_rule_set_, unicode_string, field_position, error_code);
+            if ( U_FAILURE(error_code) ) {
+                status_.Fail("ICU version:%s - an error occurred while calling icu number format function:%d", U_ICU_VERSION, error_code);
+                return;
+            }
+        }
         unicode_string.toUTF8String(string_);
+        pg::cpp::utils::SpelloutMemo::Put(memo_id_, a_number, string_);
     } else {
-        error_ = "ICU version:" + std::string(U_ICU_VERSION) + " - an error occurred while calling icu number format function:" + std::to_string(icu_error_code_);
+        status_.Fail("ICU version:%s - an error occurred while calling icu number format function:%d", U_ICU_VERSION, icu_error_code_);
     }
 }
 
@@ -98,9 +192,9 @@ void pg::cpp::utils::NumberSpellout::Spellout (double a_number)
  *
  * @throw
  */
-void pg::cpp::utils::NumberSpellout::CurrencySpellout (double a_major, const std::string& a_major_singular, const std::string& a_major_plural,
-                                            double a_minor, const std::string& a_minor_singular, const std::string& a_minor_plural,
-                                            const std::string& a_format)
+void pg::cpp::utils::NumberSpellout::CurrencySpellout (double a_major, const pg::cpp::utils::StringView& a_major_singular, const pg::cpp::utils::StringView& a_major_plural,
+                                                       double a_minor, const pg::cpp::utils::StringView& a_minor_singular, const pg::cpp::utils::StringView& a_minor_plural,
+                                                       const pg::cpp::utils::StringView& a_format)
 {
     Spellout(a_major);
     if ( not ( U_ZERO_ERROR == icu_error_code_ || U_USING_DEFAULT_WARNING == icu_error_code_ ) ) {
@@ -113,19 +207,23 @@ void pg::cpp::utils::NumberSpellout::CurrencySpellout (double a_major, const std
     }
     const std::string minor_str = string_;
 
+    const auto unicode = [] (const pg::cpp::utils::StringView& a_view) -> U_ICU_NAMESPACE::UnicodeString {
+        return U_ICU_NAMESPACE::UnicodeString::fromUTF8(U_ICU_NAMESPACE::StringPiece(a_view.Data(), static_cast<int32_t>(a_view.Length())));
+    };
+
     const U_ICU_NAMESPACE::Formattable arguments[] = {
-        a_major, a_major_singular.c_str(), a_major_plural.c_str(), major_str.c_str(),
-        a_minor, a_minor_singular.c_str(), a_minor_plural.c_str(), minor_str.c_str()
+        a_major, unicode(a_major_singular), unicode(a_major_plural), major_str.c_str(),
+        a_minor, unicode(a_minor_singular), unicode(a_minor_plural), minor_str.c_str()
     };
 
     U_ICU_NAMESPACE::UnicodeString unicode_string;
-    U_ICU_NAMESPACE::MessageFormat::format(a_format.c_str(), arguments, 8, unicode_string, icu_error_code_);
+    U_ICU_NAMESPACE::MessageFormat::format(unicode(a_format), arguments, 8, unicode_string, icu_error_code_);
 
     string_ = "";
-    error_  = "";
+    status_.Reset();
     if ( U_ZERO_ERROR == icu_error_code_ || U_USING_DEFAULT_WARNING == icu_error_code_ ) {
         unicode_string.toUTF8String(string_);
     } else {
-      error_ = "ICU version:" + std::string(U_ICU_VERSION) + " - an error occurred while calling icu message format: " + std::to_string(icu_error_code_);
+      status_.Fail("ICU version:%s - an error occurred while calling icu message format: %d", U_ICU_VERSION, icu_error_code_);
     }
 }
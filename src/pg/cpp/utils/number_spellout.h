@@ -24,9 +24,13 @@
 #define PG_CPP_UTILS_NUMBER_SPELLOUT_H_
 
 #include "pg/cpp/utils/utility.h"
+#include "pg/cpp/utils/string_view.h"
+#include "pg/cpp/utils/locale_registry.h"
+#include "pg/cpp/utils/spellout_rules.h"
+#include "pg/cpp/utils/spellout_memo.h"
 
 #include <string>          // std::string
-#include <unicode/locid.h> // ICU Locale
+#include <vector>          // std::vector
 #include <unicode/rbnf.h>  // ICU RuleBasedNumberFormat
 namespace pg
 {
@@ -40,89 +44,39 @@ namespace pg
             class NumberSpellout final : public Utility
             {
 
-            public: // Data Type(s)
-
-                class Record final : public Utility::Record
-                {
-
-                public: // Const Data
-
-                    const std::string string_;
-
-                private: // Data
-
-                    char** p_string_values_;
-
-                public: // Constructor / Destructor
-
-                    /**
-                     * @brief Default constructor.
-                     *
-                     * @param a_string
-                     */
-                    Record (const std::string& a_string)
-                    : string_(a_string)
-                    {
-                        p_string_values_ = nullptr;
-                    }
-
-                    /**
-                     * @brief Destructor.
-                     */
-                    virtual ~Record ()
-                    {
-                        if ( nullptr != p_string_values_ ) {
-                            if ( nullptr != p_string_values_[0] ) {
-                                pfree(p_string_values_[0]);
-                            }
-                            pfree(p_string_values_);
-                        }
-                    }
-
-                public: // Inherited Pure Virtual Method(s) / Function(s) - implementation
-
-                    /**
-                     * @brief Allocate memory from postgres pool and copy a record data to it.
-                     *
-                     * @return An array of string representing a record.
-                     */
-                    virtual char** PStringValues ()
-                    {
-                        char** tmp = (char**)palloc(sizeof(char*)*1);
-                        if ( nullptr == tmp ) {
-                            return nullptr;
-                        }
-
-                        tmp[0] = PCopyString(string_.c_str());
-
-                        return tmp;
-                    }
-
-                }; // end of 'Record' class
-
             private: // Data
 
-                U_ICU_NAMESPACE::Locale                 icu_locale_;
-                UErrorCode                              icu_error_code_;
-                UParseError                             icu_parse_error_;
-                U_ICU_NAMESPACE::RuleBasedNumberFormat* icu_number_format_;
-                std::string                             string_;
+                const LocaleRegistry::Entry&   locale_;
+                UErrorCode                     icu_error_code_;
+                UParseError                    icu_parse_error_;
+                SpelloutRules::Format          icu_number_format_;
+                U_ICU_NAMESPACE::UnicodeString icu_rule_set_;
+                SpelloutMemo::Id               memo_id_;
+                std::string                    string_;
+                std::vector<double>            batch_;
+                std::vector<bool>              batch_nulls_;
+                size_t                         cursor_;
 
             public: // Constructor / Destructor.
 
-                NumberSpellout (const std::string& a_locale, const std::string& a_spellout_override);
+                NumberSpellout (const StringView& a_locale, const StringView& a_spellout_override, const StringView& a_rule_set = StringView());
                 virtual ~NumberSpellout();
 
             public: // Inherited Pure Virtual Method(s) / Function(s)
 
                 virtual void FillOutputAtUserFuncContext (FuncCallContext* a_context);
 
+            public: // Inherited Virtual Method(s) / Function(s)
+
+                virtual bool Next (Records& a_records);
+
             public: // Method(s) / Function(s)
 
                 void Spellout         (double a_number);
-                void CurrencySpellout (double a_major, const std::string& a_major_singular, const std::string& a_major_plural,
-                                       double a_minor, const std::string& a_minor_singular, const std::string& a_minor_plural,
-                                       const std::string& a_format);
+                void SpelloutBatch    (const std::vector<double>& a_numbers, const std::vector<bool>& a_nulls);
+                void CurrencySpellout (double a_major, const StringView& a_major_singular, const StringView& a_major_plural,
+                                       double a_minor, const StringView& a_minor_singular, const StringView& a_minor_plural,
+                                       const StringView& a_format);
 
             }; // end of class 'NumberSpellout
 
@@ -21,7 +21,6 @@
 
 #include "pg/cpp/utils/public_link.h"
 
-#include "pg/cpp/utils/exception.h"
 #include "pg/cpp/utils/b64.h"
 
 #include "osal/osal_time.h"
@@ -29,26 +28,20 @@
 #include "cppcodec/base64_url_unpadded.hpp"
 #include "cppcodec/base64_rfc4648.hpp"
 
-#include <openssl/pem.h>
-#include <openssl/sha.h>
-#include <openssl/aes.h>
-#include <openssl/rsa.h>
-#include <openssl/evp.h>
+#include <openssl/err.h>
 
-#include <string.h> // memcpy
-
-#include <map>
+#include <map> // std::map
 
 // https://wiki.openssl.org/index.php/EVP_Symmetric_Encryption_and_Decryption
 
 /**
  * @brief Default constructor.
  *
- * @param a_key
- * @param a_iv
+ * @param a_key Base 64 AES-256 key.
+ * @param a_iv  Base 64 AES-256-CBC initialization vector.
  */
-pg::cpp::utils::PublicLink::PublicLink (const std::string& a_key, const std::string& a_iv)
-    : key_(a_key), iv_(a_iv)
+pg::cpp::utils::PublicLink::PublicLink (const pg::cpp::utils::StringView& a_key, const pg::cpp::utils::StringView& a_iv)
+    : key_(a_key.ToString()), iv_(a_iv.ToString()), ctx_(nullptr)
 {
     /* emtpy */
 }
@@ -58,7 +51,9 @@ pg::cpp::utils::PublicLink::PublicLink (const std::string& a_key, const std::str
  */
 pg::cpp::utils::PublicLink::~PublicLink ()
 {
-    /* empty */
+    if ( nullptr != ctx_ ) {
+        EVP_CIPHER_CTX_free(ctx_);
+    }
 }
 
 /**
@@ -68,8 +63,8 @@ pg::cpp::utils::PublicLink::~PublicLink ()
  */
 void pg::cpp::utils::PublicLink::FillOutputAtUserFuncContext (FuncCallContext* a_context)
 {
-    Utility::Records* records = static_cast<Utility::Records*>(a_context->user_fctx);
-    records->Append(new pg::cpp::utils::PublicLink::Record(url_));
+    Utility::Records* records = Utility::UserFuncContextRecords(a_context);
+    records->Append(1)[0] = records->Copy(url_);
     a_context->max_calls += 1;
 }
 
@@ -80,19 +75,15 @@ void pg::cpp::utils::PublicLink::FillOutputAtUserFuncContext (FuncCallContext* a
  * @param a_company_id
  * @param a_entity_type
  * @param a_entity_id
- *
- * @throw
  */
-void pg::cpp::utils::PublicLink::Calculate (const std::string& a_base_url,
-                                            const int64_t a_company_id, const std::string& a_entity_type, const int64_t a_entity_id)
+void pg::cpp::utils::PublicLink::Calculate (const pg::cpp::utils::StringView& a_base_url,
+                                            const int64_t a_company_id, const pg::cpp::utils::StringView& a_entity_type, const int64_t a_entity_id)
 {
-    unsigned char* key  = nullptr;
-    unsigned char* iv   = nullptr;
-    unsigned char* out  = nullptr;
-    int            outl = 0;
-
-    EVP_CIPHER_CTX ctx;
-    EVP_CIPHER_CTX_init(&ctx);
+    // ... OpenSSL errors are reported by the status, not left in it's queue ...
+    const auto fail = [this] (const char* const a_message) {
+        ERR_clear_error();
+        status_.Fail("%s", a_message);
+    };
 
     try {
 
@@ -102,6 +93,40 @@ void pg::cpp::utils::PublicLink::Calculate (const std::string& a_base_url,
         tmp_ss_.str("");
         url_ = "";
 
+        //
+        // CIPHER CONTEXT - allocated, and key / iv decoded, only once
+        //
+        if ( nullptr == ctx_ ) {
+            const std::map<const std::string*, std::vector<unsigned char>*> map = {
+                { &key_, &key_bytes_ },
+                { &iv_ , &iv_bytes_  }
+            };
+            for ( auto it : map ) {
+                if ( it.first->length() > 0 ) {
+                    it.second->resize(cppcodec::base64_rfc4648::decoded_max_size(it.first->length()));
+                    it.second->resize(cppcodec::base64_rfc4648::decode(it.second->data(), it.second->size(), it.first->c_str(), it.first->length()));
+                } else {
+                    it.second->clear();
+                }
+            }
+            ctx_ = EVP_CIPHER_CTX_new();
+            if ( nullptr == ctx_ ) {
+                fail("Unable to allocate cipher context!");
+                return;
+            }
+        } else {
+            //
+            // int EVP_CIPHER_CTX_reset(EVP_CIPHER_CTX *ctx);
+            //
+            // - clears all information from a cipher context and frees up any allocated memory associated with it, except the ctx itself;
+            // - returns 1 for success and 0 for failure;
+            //
+            if ( 1 != EVP_CIPHER_CTX_reset(ctx_) ) {
+                fail("Unable to reset cipher context!");
+                return;
+            }
+        }
+
         //
         // PREPARE PAYLOAD
         //
@@ -111,34 +136,9 @@ void pg::cpp::utils::PublicLink::Calculate (const std::string& a_base_url,
         pg::Json::Value object = pg::Json::Value(pg::Json::ValueType::objectValue);
         object["timestamp"]   = osal::Time::ToHumanReadableTimeISO8601WithTZ(hr_time);
         object["company_id"]  = a_company_id;
-        object["entity_type"] = a_entity_type;
+        object["entity_type"] = pg::Json::Value(a_entity_type.Data(), a_entity_type.Data() + a_entity_type.Length());
         object["entity_id"]   = a_entity_id;
 
-        //
-        // int EVP_CIPHER_CTX_set_padding(EVP_CIPHER_CTX *x, int padding);
-        //
-        // - enables or disables padding;
-        // - always returns 1;
-        //
-        if ( 1 != EVP_CIPHER_CTX_set_padding(&ctx, 1) ) {
-            EVP_CIPHER_CTX_cleanup(&ctx);
-            throw PG_CPP_UTILS_EXCEPTION_NA("Unable to set padding!");
-        }
-
-        const std::map<std::string, unsigned char**> map = {
-            { key_, &key },
-            { iv_ , &iv  }
-        };
-        for ( auto it : map ) {
-            if ( it.first.length() > 0 ) {
-                const size_t dl = cppcodec::base64_rfc4648::decoded_max_size(it.first.length());
-                (*it.second) = new unsigned char[dl];
-                cppcodec::base64_rfc4648::decode((*it.second), dl, it.first.c_str(), it.first.length());
-            } else {
-                (*it.second) = nullptr;
-            }
-        }
-
         const EVP_CIPHER* cipher = EVP_aes_256_cbc();
 
         //
@@ -147,17 +147,31 @@ void pg::cpp::utils::PublicLink::Calculate (const std::string& a_base_url,
         // - sets up cipher context ctx for encryption with cipher type from ENGINE impl;
         // - return 1 for success and 0 for failure;
         //
-        if ( 1 != EVP_EncryptInit_ex(&ctx, cipher, NULL, key, iv) ) {
-            EVP_CIPHER_CTX_cleanup(&ctx);
-            throw PG_CPP_UTILS_EXCEPTION_NA("Unable to initialize cipher!");
+        if ( 1 != EVP_EncryptInit_ex(ctx_, cipher, NULL,
+                                     key_bytes_.size() > 0 ? key_bytes_.data() : nullptr,
+                                     iv_bytes_.size()  > 0 ? iv_bytes_.data()  : nullptr) ) {
+            fail("Unable to initialize cipher!");
+            return;
+        }
+
+        //
+        // int EVP_CIPHER_CTX_set_padding(EVP_CIPHER_CTX *x, int padding);
+        //
+        // - enables or disables padding;
+        // - always returns 1;
+        //
+        if ( 1 != EVP_CIPHER_CTX_set_padding(ctx_, 1) ) {
+            fail("Unable to set padding!");
+            return;
         }
 
         const std::string    payload = fast_writer_.write(object);
         const unsigned char* in      = reinterpret_cast<const unsigned char*>(payload.c_str());
         int                  inl     = static_cast<int>(payload.length());
+        int                  outl    = 0;
 
-        out  = new unsigned char[ (inl + EVP_CIPHER_block_size(cipher) - 1) ];
-        outl = 0;
+        // ... update writes up to inl + block size - 1 bytes, final up to one ( padding ) block ...
+        out_.resize(static_cast<size_t>(inl + EVP_CIPHER_block_size(cipher)));
 
         //
         // int EVP_EncryptUpdate(EVP_CIPHER_CTX *ctx, unsigned char *out, int *outl, unsigned char *in, int inl);
@@ -165,9 +179,9 @@ void pg::cpp::utils::PublicLink::Calculate (const std::string& a_base_url,
         // - encrypts inl bytes from the buffer in and writes the encrypted version to out;
         // - return 1 for success and 0 for failure;
         //
-        if ( 1 != EVP_EncryptUpdate(&ctx, out, &outl, in, inl) ) {
-            EVP_CIPHER_CTX_cleanup(&ctx);
-            throw PG_CPP_UTILS_EXCEPTION_NA("Unable to update encryption!");
+        if ( 1 != EVP_EncryptUpdate(ctx_, out_.data(), &outl, in, inl) ) {
+            fail("Unable to update encryption!");
+            return;
         }
 
         int encrypted_length = outl;
@@ -178,57 +192,25 @@ void pg::cpp::utils::PublicLink::Calculate (const std::string& a_base_url,
         // - encrypts the "final" data, that is any data that remains in a partial block;
         // - return 1 for success and 0 for failure;
         //
-        if ( 1 != EVP_EncryptFinal_ex(&ctx, out + encrypted_length, &outl) ) {
-            EVP_CIPHER_CTX_cleanup(&ctx);
-            throw PG_CPP_UTILS_EXCEPTION_NA("Unable to finalize encryption!");
+        if ( 1 != EVP_EncryptFinal_ex(ctx_, out_.data() + encrypted_length, &outl) ) {
+            fail("Unable to finalize encryption!");
+            return;
         }
         encrypted_length += outl;
 
-        const std::string b64 = cppcodec::base64_url_unpadded::encode(out, static_cast<size_t>(encrypted_length));
-
-        //
-        //
-        // int EVP_CIPHER_CTX_cleanup(EVP_CIPHER_CTX *a);
-        //
-        // - returns 1 for success and 0 for failure.
-        //
-        EVP_CIPHER_CTX_cleanup(&ctx);
-        delete [] out;
-        if ( nullptr != key ) {
-            delete [] key;
-        }
-        if ( nullptr != iv ) {
-            delete [] iv;
-        }
+        const std::string b64 = cppcodec::base64_url_unpadded::encode(out_.data(), static_cast<size_t>(encrypted_length));
 
         //
         // set URL
         //
-        tmp_ss_ << a_base_url << "/" << b64;
+        tmp_ss_.write(a_base_url.Data(), static_cast<std::streamsize>(a_base_url.Length()));
+        tmp_ss_ << "/" << b64;
         url_ = tmp_ss_.str();
 
-    } catch (const pg::cpp::utils::Exception& a_pg_cpp_utils_exception) {
-        if ( nullptr != out ) {
-            delete [] out;
-        }
-        if ( nullptr != key ) {
-            delete [] key;
-        }
-        if ( nullptr != iv ) {
-            delete [] iv;
-        }
-        throw a_pg_cpp_utils_exception;
+    } catch (const cppcodec::parse_error& a_parse_error) {
+        status_.Fail("Key or iv is not valid base 64: %s", a_parse_error.what());
     } catch (const pg::Json::Exception& a_json_exception) {
-        if ( nullptr != out ) {
-            delete [] out;
-        }
-        if ( nullptr != key ) {
-            delete [] key;
-        }
-        if ( nullptr != iv ) {
-            delete [] iv;
-        }
-        throw PG_CPP_UTILS_EXCEPTION("%s", a_json_exception.what());
+        status_.Fail("%s", a_json_exception.what());
     }
 
 }
@@ -24,10 +24,14 @@
 #define PG_CPP_UTILS_PUBLIC_LINK_H_
 
 #include "pg/cpp/utils/utility.h"
+#include "pg/cpp/utils/string_view.h"
 
 #include <string>     // std::string
 #include <sstream>    // std::stringstream
 #include <functional> // std::function
+#include <vector>     // std::vector
+
+#include <openssl/evp.h>
 
 #include "jsoncpp/json.h"
 
@@ -43,66 +47,6 @@ namespace pg
             class PublicLink final : public Utility
             {
 
-            public: // Data Type(s)
-
-                class Record final : public Utility::Record
-                {
-
-                public: // Const Data
-
-                    const std::string url_;
-
-                private: // Data
-
-                    char** p_string_values_;
-
-                public: // Constructor / Destructor
-
-                    /**
-                     * @brief Default constructor.
-                     *
-                     * @param a_url
-                     */
-                    Record (const std::string& a_url)
-                        : url_(a_url)
-                    {
-                        p_string_values_ = nullptr;
-                    }
-
-                    /**
-                     * @brief Destructor.
-                     */
-                    virtual ~Record ()
-                    {
-                        if ( nullptr != p_string_values_ ) {
-                            if ( nullptr != p_string_values_[0] ) {
-                                pfree(p_string_values_[0]);
-                            }
-                            pfree(p_string_values_);
-                        }
-                    }
-
-                public: // Inherited Pure Virtual Method(s) / Function(s) - implementation
-
-                    /**
-                     * @brief Allocate memory from postgres pool and copy a record data to it.
-                     *
-                     * @return An array of string representing a record.
-                     */
-                    virtual char** PStringValues ()
-                    {
-                        char** tmp = (char**)palloc(sizeof(char*)*1);
-                        if ( nullptr == tmp ) {
-                            return nullptr;
-                        }
-
-                        tmp[0] = PCopyString(url_.c_str());
-
-                        return tmp;
-                    }
-
-                }; // end of 'Record' class
-
             private: // Const Data
 
                 const std::string key_;
@@ -110,14 +54,17 @@ namespace pg
 
             private: // Data
 
-                std::string          url_;
-                std::stringstream    tmp_ss_;
-                pg::Json::FastWriter fast_writer_;
-
+                std::vector<unsigned char> key_bytes_;
+                std::vector<unsigned char> iv_bytes_;
+                EVP_CIPHER_CTX*            ctx_;
+                std::vector<unsigned char> out_;
+                std::string                url_;
+                std::stringstream          tmp_ss_;
+                pg::Json::FastWriter       fast_writer_;
 
             public: // Constructor / Destructor.
 
-                PublicLink (const std::string& a_key, const std::string& a_iv);
+                PublicLink (const StringView& a_key, const StringView& a_iv);
                 virtual ~PublicLink();
 
             public: // Inherited Pure Virtual Method(s) / Function(s)
@@ -126,8 +73,8 @@ namespace pg
 
             public: // Method(s) / Function(s)
 
-                void Calculate (const std::string& a_base_url,
-                                const int64_t a_company_id, const std::string& a_entity_type, const int64_t a_entity_id);
+                void Calculate (const StringView& a_base_url,
+                                const int64_t a_company_id, const StringView& a_entity_type, const int64_t a_entity_id);
 
             }; // end of class 'PublicLink'
 
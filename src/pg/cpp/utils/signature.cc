@@ -0,0 +1,121 @@
+/**
+ * @file signature.cc
+ *
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pg/cpp/utils/signature.h"
+
+#include "pg/cpp/utils/b64.h"
+
+#include "cppcodec/base64_rfc4648.hpp"
+
+/**
+ * @brief Default constructor.
+ *
+ * @param a_key        Private key when signing, public key ( or certificate ) when verifying.
+ * @param a_key_source PEM file path, or PEM / DER key material.
+ * @param a_algorithm
+ */
+pg::cpp::utils::Signature::Signature (const pg::cpp::utils::StringView& a_key, const pg::cpp::utils::KeyCache::Source a_key_source,
+                                      const pg::cpp::utils::Signer::Algorithm a_algorithm)
+    : key_(a_key.ToString()), key_source_(a_key_source), algorithm_(a_algorithm), verify_(false), valid_(false)
+{
+    /* empty */
+}
+
+/**
+ * @brief Destructor.
+ */
+pg::cpp::utils::Signature::~Signature ()
+{
+    /* empty */
+}
+
+/**
+ * @brief Fill user provided context information.
+ *
+ * @param a_context
+ */
+void pg::cpp::utils::Signature::FillOutputAtUserFuncContext (FuncCallContext* a_context)
+{
+    Utility::Records* records = Utility::UserFuncContextRecords(a_context);
+    if ( true == verify_ ) {
+        records->Append({ valid_ ? "t" : "f" });
+    } else {
+        records->Append(1)[0] = records->Copy(signature_);
+    }
+    a_context->max_calls += 1;
+}
+
+/**
+ * @brief Sign a payload.
+ *
+ * @param a_payload
+ */
+void pg::cpp::utils::Signature::Sign (const pg::cpp::utils::StringView& a_payload)
+{
+    pg::cpp::utils::B64 b64;
+
+    verify_    = false;
+    signature_ = "";
+
+    // ... parsed once per backend, see KeyCache ...
+    EVP_PKEY* pkey = pg::cpp::utils::KeyCache::Get(key_, pg::cpp::utils::KeyCache::Type::Private, key_source_, status_);
+    if ( nullptr == pkey ) {
+        return;
+    }
+
+    const std::vector<unsigned char>* signature = signer_.Sign(pkey, algorithm_, a_payload.Data(), a_payload.Length(), status_);
+    if ( nullptr == signature ) {
+        return;
+    }
+
+    signature_ = b64.Encode(signature->data(), static_cast<unsigned int>(signature->size()));
+}
+
+/**
+ * @brief Verify a payload signature.
+ *
+ * @param a_payload
+ * @param a_signature Base 64 signature, as calculated by \link Sign \link.
+ */
+void pg::cpp::utils::Signature::Verify (const pg::cpp::utils::StringView& a_payload, const pg::cpp::utils::StringView& a_signature)
+{
+    verify_ = true;
+    valid_  = false;
+
+    // ... parsed once per backend, see KeyCache ...
+    EVP_PKEY* pkey = pg::cpp::utils::KeyCache::Get(key_, pg::cpp::utils::KeyCache::Type::Public, key_source_, status_);
+    if ( nullptr == pkey ) {
+        return;
+    }
+
+    // ... a signature that is not base 64 can't be valid ...
+    try {
+        signature_bytes_.resize(cppcodec::base64_rfc4648::decoded_max_size(a_signature.Length()));
+        signature_bytes_.resize(cppcodec::base64_rfc4648::decode(signature_bytes_.data(), signature_bytes_.size(),
+                                                                 a_signature.Data(), a_signature.Length()));
+    } catch (const cppcodec::parse_error&) {
+        valid_ = false;
+        return;
+    }
+
+    valid_ = signer_.Verify(pkey, algorithm_, a_payload.Data(), a_payload.Length(), signature_bytes_.data(), signature_bytes_.size(), status_);
+}
@@ -0,0 +1,86 @@
+/**
+ * @file signature.h
+ *
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef PG_CPP_UTILS_SIGNATURE_H_
+#define PG_CPP_UTILS_SIGNATURE_H_
+
+#include "pg/cpp/utils/utility.h"
+#include "pg/cpp/utils/key_cache.h"
+#include "pg/cpp/utils/signer.h"
+#include "pg/cpp/utils/string_view.h"
+
+#include <string> // std::string
+#include <vector> // std::vector
+
+namespace pg
+{
+
+    namespace cpp
+    {
+
+        namespace utils
+        {
+
+            /**
+             * @brief Generic ( non-certification ) payload signing, see \link Signer::Algorithm \link.
+             */
+            class Signature final : public Utility
+            {
+
+            private: // Const Data
+
+                const std::string       key_;
+                const KeyCache::Source  key_source_;
+                const Signer::Algorithm algorithm_;
+
+            private: // Data
+
+                std::string                signature_;
+                bool                       verify_;
+                bool                       valid_;
+                Signer                     signer_;
+                std::vector<unsigned char> signature_bytes_; // decoded signature, reused across rows
+
+            public: // Constructor / Destructor.
+
+                Signature (const StringView& a_key, const KeyCache::Source a_key_source, const Signer::Algorithm a_algorithm);
+                virtual ~Signature();
+
+            public: // Inherited Pure Virtual Method(s) / Function(s)
+
+                virtual void FillOutputAtUserFuncContext (FuncCallContext* a_context);
+
+            public: // Method(s) / Function(s)
+
+                void Sign   (const StringView& a_payload);
+                void Verify (const StringView& a_payload, const StringView& a_signature);
+
+            }; // end of class 'Signature'
+
+        } // end of namespace 'utils'
+
+    } // end of namespace 'cpp'
+
+} // end of namespace pg
+
+#endif // PG_CPP_UTILS_SIGNATURE_H_
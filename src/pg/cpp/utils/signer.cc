@@ -0,0 +1,232 @@
+/**
+ * @file signer.cc
+ *
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pg/cpp/utils/signer.h"
+
+#include "pg/cpp/utils/exception.h"
+
+#include <openssl/rsa.h>
+#include <openssl/err.h>
+
+#if OPENSSL_VERSION_NUMBER < 0x10101000L
+    #error "OpenSSL 1.1.1 or later is required ( one-shot EVP_DigestSign / EVP_DigestVerify, Ed25519 )"
+#endif
+
+const EVP_MD* pg::cpp::utils::Signer::s_md_[static_cast<size_t>(pg::cpp::utils::Signer::Algorithm::Count)] = { nullptr };
+
+/**
+ * @brief Default constructor.
+ */
+pg::cpp::utils::Signer::Signer ()
+    : ctx_(nullptr)
+{
+    /* empty */
+}
+
+/**
+ * @brief Destructor.
+ */
+pg::cpp::utils::Signer::~Signer ()
+{
+    if ( nullptr != ctx_ ) {
+        EVP_MD_CTX_free(ctx_);
+    }
+}
+
+/**
+ * @brief Sign a payload.
+ *
+ * @param a_pkey      Private key, see \link KeyCache \link.
+ * @param a_algorithm
+ * @param a_data
+ * @param a_size
+ * @param o_status  Set to failed when the payload can't be signed.
+ *
+ * @return Signature bytes, valid until the next call - nullptr on failure.
+ */
+const std::vector<unsigned char>* pg::cpp::utils::Signer::Sign (EVP_PKEY* a_pkey, const pg::cpp::utils::Signer::Algorithm a_algorithm,
+                                                                const void* a_data, const size_t a_size,
+                                                                pg::cpp::utils::Status& o_status)
+{
+    if ( nullptr == Init(a_pkey, a_algorithm, /* a_sign */ true, o_status) ) {
+        return nullptr;
+    }
+
+    size_t size = static_cast<size_t>(EVP_PKEY_size(a_pkey));
+    signature_.resize(size);
+
+    if ( 1 != EVP_DigestSign(ctx_, signature_.data(), &size, static_cast<const unsigned char*>(a_data), a_size) ) {
+        ERR_clear_error();
+        o_status.Fail("Error while signing with %s!", Name(a_algorithm));
+        return nullptr;
+    }
+    signature_.resize(size);
+
+    return &signature_;
+}
+
+/**
+ * @brief Verify a payload signature.
+ *
+ * @param a_pkey           Public key, see \link KeyCache \link.
+ * @param a_algorithm
+ * @param a_data
+ * @param a_size
+ * @param a_signature
+ * @param a_signature_size
+ * @param o_status         Set to failed when the signature can't be verified at all, e.g. the key does not support \p a_algorithm.
+ *
+ * @return True if the signature is valid.
+ */
+bool pg::cpp::utils::Signer::Verify (EVP_PKEY* a_pkey, const pg::cpp::utils::Signer::Algorithm a_algorithm,
+                                     const void* a_data, const size_t a_size,
+                                     const unsigned char* a_signature, const size_t a_signature_size,
+                                     pg::cpp::utils::Status& o_status)
+{
+    if ( nullptr == Init(a_pkey, a_algorithm, /* a_sign */ false, o_status) ) {
+        return false;
+    }
+
+    // ... 1 valid, 0 invalid, < 0 malformed signature - also invalid ...
+    const int rv = EVP_DigestVerify(ctx_, a_signature, a_signature_size, static_cast<const unsigned char*>(a_data), a_size);
+    ERR_clear_error();
+
+    return ( 1 == rv );
+}
+
+/**
+ * @brief Translate a SQL algorithm name.
+ *
+ * @param a_name One of 'rsa-sha1', 'rsa-sha256', 'rsa-pss-sha256' or 'ed25519'.
+ *
+ * @throw
+ */
+pg::cpp::utils::Signer::Algorithm pg::cpp::utils::Signer::AlgorithmFromName (const pg::cpp::utils::StringView& a_name)
+{
+    for ( uint8_t idx = 0 ; idx < static_cast<uint8_t>(Algorithm::Count) ; ++idx ) {
+        const Algorithm algorithm = static_cast<Algorithm>(idx);
+        if ( true == a_name.Equals(Name(algorithm)) ) {
+            return algorithm;
+        }
+    }
+    throw PG_CPP_UTILS_EXCEPTION("Unsupported signature algorithm '%.*s'!", static_cast<int>(a_name.Length()), a_name.Data());
+}
+
+/**
+ * @return SQL name of an algorithm.
+ *
+ * @param a_algorithm
+ */
+const char* pg::cpp::utils::Signer::Name (const pg::cpp::utils::Signer::Algorithm a_algorithm)
+{
+    switch (a_algorithm) {
+        case Algorithm::RSA_SHA1:
+            return "rsa-sha1";
+        case Algorithm::RSA_SHA256:
+            return "rsa-sha256";
+        case Algorithm::RSA_PSS_SHA256:
+            return "rsa-pss-sha256";
+        case Algorithm::Ed25519:
+            return "ed25519";
+        default:
+            return "???";
+    }
+}
+
+/**
+ * @brief Reset the digest context, allocating it only once, and set it up for a new signature.
+ *
+ * @param a_pkey
+ * @param a_algorithm
+ * @param a_sign      True to sign, false to verify.
+ * @param o_status
+ *
+ * @return The context's public key context, owned by the digest context - nullptr, with \p o_status set, on failure.
+ */
+EVP_PKEY_CTX* pg::cpp::utils::Signer::Init (EVP_PKEY* a_pkey, const pg::cpp::utils::Signer::Algorithm a_algorithm, const bool a_sign,
+                                            pg::cpp::utils::Status& o_status)
+{
+    if ( nullptr == ctx_ ) {
+        ctx_ = EVP_MD_CTX_new();
+        if ( nullptr == ctx_ ) {
+            o_status.Fail("Error while allocating signing context!");
+            return nullptr;
+        }
+    } else {
+        EVP_MD_CTX_reset(ctx_);
+    }
+
+    const EVP_MD* md = Digest(a_algorithm, o_status);
+    if ( true == o_status.Failed() ) {
+        return nullptr;
+    }
+
+    EVP_PKEY_CTX* pctx = nullptr;
+
+    const int rv = ( true == a_sign ? EVP_DigestSignInit(ctx_, &pctx, md, nullptr, a_pkey)
+                                    : EVP_DigestVerifyInit(ctx_, &pctx, md, nullptr, a_pkey) );
+    if ( 1 != rv ) {
+        ERR_clear_error();
+        o_status.Fail("Error while setting up %s context - key does not support %s!", a_sign ? "signing" : "verification", Name(a_algorithm));
+        return nullptr;
+    }
+
+    if ( Algorithm::RSA_PSS_SHA256 == a_algorithm ) {
+        if ( EVP_PKEY_CTX_set_rsa_padding(pctx, RSA_PKCS1_PSS_PADDING) <= 0 || EVP_PKEY_CTX_set_rsa_pss_saltlen(pctx, RSA_PSS_SALTLEN_DIGEST) <= 0 ) {
+            ERR_clear_error();
+            o_status.Fail("Error while setting up %s padding!", Name(a_algorithm));
+            return nullptr;
+        }
+    }
+
+    return pctx;
+}
+
+/**
+ * @return Message digest of an algorithm, nullptr for Ed25519 ( no pre-hash ) or, with \p o_status set, on failure.
+ *
+ * @remarks Fetched lazily into a static: call it from the backend thread before signing from other threads.
+ *
+ * @param a_algorithm
+ * @param o_status    Set to failed when the digest can't be fetched.
+ */
+const EVP_MD* pg::cpp::utils::Signer::Digest (const pg::cpp::utils::Signer::Algorithm a_algorithm, pg::cpp::utils::Status& o_status)
+{
+    if ( Algorithm::Ed25519 == a_algorithm ) {
+        return nullptr;
+    }
+    const EVP_MD*& md = s_md_[static_cast<size_t>(a_algorithm)];
+    if ( nullptr == md ) {
+        const bool sha1 = ( Algorithm::RSA_SHA1 == a_algorithm );
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+        // ... fetched once per backend, instead of an implicit provider lookup per EVP_DigestSignInit ...
+        md = EVP_MD_fetch(nullptr, sha1 ? "SHA1" : "SHA256", nullptr);
+#else
+        md = ( sha1 ? EVP_sha1() : EVP_sha256() );
+#endif
+        if ( nullptr == md ) {
+            ERR_clear_error();
+            o_status.Fail("Error while fetching %s digest!", Name(a_algorithm));
+        }
+    }
+    return md;
+}
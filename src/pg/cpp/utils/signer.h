@@ -0,0 +1,102 @@
+/**
+ * @file signer.h
+ *
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef PG_CPP_UTILS_SIGNER_H_
+#define PG_CPP_UTILS_SIGNER_H_
+
+#include <openssl/evp.h>
+
+#include <stdint.h> // uint8_t
+#include <stddef.h> // size_t
+
+#include <vector> // std::vector
+
+#include "pg/cpp/utils/string_view.h"
+#include "pg/cpp/utils/status.h"
+
+namespace pg
+{
+
+    namespace cpp
+    {
+
+        namespace utils
+        {
+
+            /**
+             * @brief EVP_DigestSign / EVP_DigestVerify wrapper, owning a heap digest context that is reset and reused between signatures.
+             */
+            class Signer final
+            {
+
+            public: // Data Type(s)
+
+                enum class Algorithm : uint8_t
+                {
+                    RSA_SHA1 = 0,   // PKCS #1 v1.5, required for certified invoice hashes
+                    RSA_SHA256,     // PKCS #1 v1.5
+                    RSA_PSS_SHA256, // PSS, salt length = digest length
+                    Ed25519,
+                    Count
+                };
+
+            private: // Static Data
+
+                static const EVP_MD* s_md_[static_cast<size_t>(Algorithm::Count)];
+
+            private: // Data
+
+                EVP_MD_CTX*                ctx_;
+                std::vector<unsigned char> signature_;
+
+            public: // Constructor / Destructor.
+
+                Signer ();
+                virtual ~Signer();
+
+            public: // Method(s) / Function(s)
+
+                const std::vector<unsigned char>* Sign   (EVP_PKEY* a_pkey, const Algorithm a_algorithm, const void* a_data, const size_t a_size,
+                                                          Status& o_status);
+                bool                              Verify (EVP_PKEY* a_pkey, const Algorithm a_algorithm, const void* a_data, const size_t a_size,
+                                                          const unsigned char* a_signature, const size_t a_signature_size, Status& o_status);
+
+            public: // Static Method(s) / Function(s)
+
+                static Algorithm     AlgorithmFromName (const StringView& a_name);
+                static const char*   Name              (const Algorithm a_algorithm);
+                static const EVP_MD* Digest            (const Algorithm a_algorithm, Status& o_status);
+
+            private: // Method(s) / Function(s)
+
+                EVP_PKEY_CTX* Init (EVP_PKEY* a_pkey, const Algorithm a_algorithm, const bool a_sign, Status& o_status);
+
+            }; // end of class 'Signer'
+
+        } // end of namespace 'utils'
+
+    } // end of namespace 'cpp'
+
+} // end of namespace 'pg'
+
+#endif // PG_CPP_UTILS_SIGNER_H_
@@ -0,0 +1,160 @@
+/**
+ * @file spellout_memo.cc
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "pg/cpp/utils/spellout_memo.h"
+
+#include <math.h> // trunc, fabs
+
+#include <set> // std::set
+
+std::map<std::pair<const void*, std::string>, pg::cpp::utils::SpelloutMemo::Id>                                 pg::cpp::utils::SpelloutMemo::s_ids_;
+pg::cpp::utils::SpelloutMemo::Id                                                                                pg::cpp::utils::SpelloutMemo::s_next_id_ = 1;
+pg::cpp::utils::LRUCache<pg::cpp::utils::SpelloutMemo::Key, std::string, pg::cpp::utils::SpelloutMemo::KeyHash> pg::cpp::utils::SpelloutMemo::s_cache_("spellout_memo", 4096);
+
+/**
+ * @brief Mix formatter id and value.
+ *
+ * @param a_key
+ */
+size_t pg::cpp::utils::SpelloutMemo::KeyHash::operator() (const pg::cpp::utils::SpelloutMemo::Key& a_key) const
+{
+    uint64_t hash = static_cast<uint64_t>(a_key.second) ^ ( static_cast<uint64_t>(a_key.first) << 48 );
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return static_cast<size_t>(hash);
+}
+
+/**
+ * @brief Obtain the memo id of a cached formatter and rule set.
+ *
+ * @remarks Ids are never reused, so a formatter released by a reset can't serve results under a stale id.
+ *
+ * @param a_format   Formatter, must outlive the \link Forget \link or \link Reset \link that follows it's release.
+ * @param a_rule_set Rule set, empty for the formatter's default one.
+ *
+ * @return Memo id.
+ */
+pg::cpp::utils::SpelloutMemo::Id pg::cpp::utils::SpelloutMemo::Register (const void* a_format, const pg::cpp::utils::StringView& a_rule_set)
+{
+    const std::pair<const void*, std::string> key(a_format, std::string(a_rule_set.Data(), a_rule_set.Length()));
+
+    const auto it = s_ids_.find(key);
+    if ( s_ids_.end() != it ) {
+        return it->second;
+    }
+    const Id id = s_next_id_++;
+    s_ids_[key] = id;
+
+    return id;
+}
+
+/**
+ * @brief Lookup a memoized spellout.
+ *
+ * @param a_id
+ * @param a_value
+ * @param o_string Spellout, only set when found.
+ *
+ * @return True when found.
+ */
+bool pg::cpp::utils::SpelloutMemo::Get (const pg::cpp::utils::SpelloutMemo::Id a_id, const double a_value, std::string& o_string)
+{
+    if ( 0 == a_id || 0 == s_cache_.Limit() || false == IsIntegral(a_value) ) {
+        return false;
+    }
+
+    const std::string* string = s_cache_.Find(Key(a_id, static_cast<int64_t>(a_value)));
+    if ( nullptr == string ) {
+        return false;
+    }
+    o_string = *string;
+
+    return true;
+}
+
+/**
+ * @brief Memoize a spellout, evicting least recently used ones when full.
+ *
+ * @param a_id
+ * @param a_value
+ * @param a_string
+ */
+void pg::cpp::utils::SpelloutMemo::Put (const pg::cpp::utils::SpelloutMemo::Id a_id, const double a_value, const std::string& a_string)
+{
+    if ( 0 == a_id || 0 == s_cache_.Limit() || false == IsIntegral(a_value) ) {
+        return;
+    }
+
+    (void)s_cache_.Insert(Key(a_id, static_cast<int64_t>(a_value)), std::string(a_string), a_string.length());
+}
+
+/**
+ * @brief Change the number of memoized spellouts, least recently used ones are evicted; 0 disables the memo.
+ *
+ * @param a_capacity
+ */
+void pg::cpp::utils::SpelloutMemo::Resize (const size_t a_capacity)
+{
+    s_cache_.Limit(a_capacity);
+}
+
+/**
+ * @brief Forget the ids of a formatter that left the formatters cache, so one later allocated at the same address can't
+ *        be served it's spellouts; those are released now.
+ *
+ * @param a_format
+ */
+void pg::cpp::utils::SpelloutMemo::Forget (const void* a_format)
+{
+    std::set<Id> ids;
+
+    auto it = s_ids_.lower_bound(std::make_pair(a_format, std::string()));
+    while ( s_ids_.end() != it && a_format == it->first.first ) {
+        ids.insert(it->second);
+        it = s_ids_.erase(it);
+    }
+    if ( true == ids.empty() ) {
+        return;
+    }
+
+    (void)s_cache_.EraseIf([&ids] (const Key& a_key, const std::string& /* a_string */) -> bool {
+        return ids.end() != ids.find(a_key.first);
+    });
+}
+
+/**
+ * @brief Forget all memoized spellouts and formatter ids, must be called when cached formatters are released.
+ */
+void pg::cpp::utils::SpelloutMemo::Reset ()
+{
+    (void)s_cache_.Clear();
+    s_ids_.clear();
+}
+
+/**
+ * @return True when a value is integral and exactly representable, only those are memoized.
+ *
+ * @param a_value
+ */
+bool pg::cpp::utils::SpelloutMemo::IsIntegral (const double a_value)
+{
+    return trunc(a_value) == a_value && fabs(a_value) < 9007199254740992.0 /* 2^53 */;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file spellout_memo.h
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#ifndef PG_CPP_UTILS_SPELLOUT_MEMO_H_
+#define PG_CPP_UTILS_SPELLOUT_MEMO_H_
+
+#include "pg/cpp/utils/string_view.h"
+#include "pg/cpp/utils/cache.h"
+
+#include <stdint.h> // uint32_t, int64_t
+#include <stddef.h> // size_t
+
+#include <string>  // std::string
+#include <map>     // std::map
+#include <utility> // std::pair
+
+namespace pg
+{
+
+    namespace cpp
+    {
+
+        namespace utils
+        {
+
+            /**
+             * @brief Backend wide, bounded, least recently used memo of integral spellouts, keyed by ( formatter id, value ),
+             *        so repeated amounts skip the RBNF engine.
+             *
+             * @remarks Bounded by pg_cpp_utils.spellout_memo_size entries and by the \link Cache \link memory budget.
+             */
+            class SpelloutMemo final
+            {
+
+            public: // Data Type(s)
+
+                typedef uint32_t Id; // 0, formatter is not memoized
+
+            private: // Data Type(s)
+
+                typedef std::pair<Id, int64_t> Key;
+
+                struct KeyHash
+                {
+                    size_t operator() (const Key& a_key) const;
+                };
+
+            private: // Static Data
+
+                static std::map<std::pair<const void*, std::string>, Id> s_ids_;
+                static Id                                                s_next_id_;
+                static LRUCache<Key, std::string, KeyHash>               s_cache_;
+
+            public: // Static Method(s) / Function(s)
+
+                static Id   Register (const void* a_format, const StringView& a_rule_set);
+                static bool Get      (const Id a_id, const double a_value, std::string& o_string);
+                static void Put      (const Id a_id, const double a_value, const std::string& a_string);
+                static void Resize   (const size_t a_capacity);
+                static void Forget   (const void* a_format);
+                static void Reset    ();
+
+            private: // Static Method(s) / Function(s)
+
+                static bool IsIntegral (const double a_value);
+
+            }; // end of class 'SpelloutMemo'
+
+        } // end of namespace 'utils'
+
+    } // end of namespace 'cpp'
+
+} // end of namespace 'pg'
+
+#endif // PG_CPP_UTILS_SPELLOUT_MEMO_H_
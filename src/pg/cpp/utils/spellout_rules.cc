@@ -0,0 +1,241 @@
+/**
+ * @file spellout_rules.cc
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pg/cpp/utils/spellout_rules.h"
+
+#include "pg/cpp/utils/spellout_memo.h"
+
+#include "pg/cpp/utils/exception.h"
+
+std::map<std::string, pg::cpp::utils::SpelloutRules::Locales>                                                                                                                       pg::cpp::utils::SpelloutRules::s_names_;
+pg::cpp::utils::LRUCache<pg::cpp::utils::SpelloutRules::Key, pg::cpp::utils::SpelloutRules::Format, pg::cpp::utils::SpelloutRules::KeyHash, pg::cpp::utils::SpelloutRules::Release> pg::cpp::utils::SpelloutRules::s_formats_("spellout_formats");
+
+/**
+ * @brief Mix rule set name and locale id.
+ *
+ * @param a_key
+ */
+size_t pg::cpp::utils::SpelloutRules::KeyHash::operator() (const pg::cpp::utils::SpelloutRules::Key& a_key) const
+{
+    return std::hash<std::string>()(a_key.first) ^ ( static_cast<size_t>(a_key.second) * 0x9e3779b97f4a7c15ULL );
+}
+
+/**
+ * @brief A formatter left the cache, it's memoized spellouts can't outlive it.
+ *
+ * @param a_key
+ * @param a_format
+ */
+void pg::cpp::utils::SpelloutRules::Release::operator() (const pg::cpp::utils::SpelloutRules::Key& /* a_key */,
+                                                         const pg::cpp::utils::SpelloutRules::Format& a_format) const
+{
+    pg::cpp::utils::SpelloutMemo::Forget(a_format.get());
+}
+
+/**
+ * @brief Check if a spellout override is a rule set name rather than RBNF text.
+ *
+ * @param a_override
+ *
+ * @return True for 1 to 63 letters, digits, '_', '.' or '-'.
+ */
+bool pg::cpp::utils::SpelloutRules::IsName (const pg::cpp::utils::StringView& a_override)
+{
+    if ( true == a_override.Empty() || a_override.Length() > 63 ) {
+        return false;
+    }
+    for ( size_t idx = 0 ; idx < a_override.Length() ; ++idx ) {
+        const char c = a_override.Data()[idx];
+        if ( not ( ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' ) || ( c >= '0' && c <= '9' ) || '_' == c || '.' == c || '-' == c ) ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Check if a rule set name was already loaded, even if no rules were found for it.
+ *
+ * @param a_name
+ */
+bool pg::cpp::utils::SpelloutRules::IsLoaded (const pg::cpp::utils::StringView& a_name)
+{
+    return s_names_.end() != s_names_.find(a_name.ToString());
+}
+
+/**
+ * @brief Keep the definitions of a rule set name, they are only compiled when used.
+ *
+ * @param a_name
+ * @param a_definitions Locale and RBNF text pairs, may be empty.
+ *
+ * @throw
+ */
+void pg::cpp::utils::SpelloutRules::Load (const pg::cpp::utils::StringView& a_name, const std::vector<pg::cpp::utils::SpelloutRules::Definition>& a_definitions)
+{
+    Locales locales;
+    for ( auto& definition : a_definitions ) {
+        locales[LocaleRegistry::Intern(definition.first)] = definition.second.ToString();
+    }
+
+    const std::string name = a_name.ToString();
+    (void)s_formats_.EraseIf([&name] (const Key& a_key, const Format& /* a_format */) -> bool {
+        return a_key.first == name;
+    });
+    s_names_[name].swap(locales);
+}
+
+/**
+ * @brief Obtain the compiled rules of a loaded name for a locale, or for it's language if there's none for the locale.
+ *
+ * @param a_name
+ * @param a_locale
+ * @param o_status Set to failed when the rules are not loaded or not registered for the locale.
+ *
+ * @return Formatter shared with the cache, it outlives a \link Reset \link while in use; empty on failure.
+ *
+ * @throw Only when the rules do not compile, they are validated before being stored.
+ */
+pg::cpp::utils::SpelloutRules::Format pg::cpp::utils::SpelloutRules::Get (const pg::cpp::utils::StringView& a_name, const pg::cpp::utils::LocaleRegistry::Entry& a_locale,
+                                                                           pg::cpp::utils::Status& o_status)
+{
+    const auto name = s_names_.find(a_name.ToString());
+    if ( s_names_.end() == name ) {
+        o_status.Fail("Spellout rules '%.*s' are not loaded", static_cast<int>(a_name.Length()), a_name.Data());
+        return Format();
+    }
+
+    auto it = name->second.find(a_locale.id_);
+    if ( name->second.end() == it ) {
+        it = name->second.find(LocaleRegistry::Intern(a_locale.locale_.getLanguage()));
+    }
+    if ( name->second.end() == it ) {
+        o_status.Fail("Spellout rules '%.*s' are not registered for locale '%s'",
+                      static_cast<int>(a_name.Length()), a_name.Data(), a_locale.name_.c_str());
+        return Format();
+    }
+
+    const Key     key(name->first, it->first);
+    const Format* format = s_formats_.Find(key);
+    if ( nullptr != format ) {
+        return *format;
+    }
+
+    return Insert(key, Compile(StringView(it->second), a_locale.locale_));
+}
+
+/**
+ * @brief Obtain ICU's built-in spellout rules for a locale, created only once per backend.
+ *
+ * @remarks Shared formatters are never modified: rule sets other than the default are selected per format call.
+ *
+ * @param a_locale
+ * @param o_status Set to failed when ICU can't create the formatter.
+ *
+ * @return Formatter shared with the cache, empty on failure.
+ */
+pg::cpp::utils::SpelloutRules::Format pg::cpp::utils::SpelloutRules::BuiltIn (const pg::cpp::utils::LocaleRegistry::Entry& a_locale, pg::cpp::utils::Status& o_status)
+{
+    const Key     key(std::string(), a_locale.id_);
+    const Format* cached = s_formats_.Find(key);
+    if ( nullptr != cached ) {
+        return *cached;
+    }
+
+    UErrorCode icu_error_code = U_ZERO_ERROR;
+
+    Format format(new U_ICU_NAMESPACE::RuleBasedNumberFormat(U_ICU_NAMESPACE::URBNFRuleSetTag::URBNF_SPELLOUT, a_locale.locale_, icu_error_code));
+    if ( U_FAILURE(icu_error_code) ) {
+        o_status.Fail("ICU version: %s - an error occurred while initializing RuleBasedNumberFormat for locale '%s': %s",
+                      U_ICU_VERSION, a_locale.name_.c_str(), u_errorName(icu_error_code));
+        return Format();
+    }
+    return Insert(key, std::move(format));
+}
+
+/**
+ * @brief Check if RBNF text compiles.
+ *
+ * @param a_locale
+ * @param a_rules
+ *
+ * @throw
+ */
+void pg::cpp::utils::SpelloutRules::Validate (const pg::cpp::utils::StringView& a_locale, const pg::cpp::utils::StringView& a_rules)
+{
+    (void)Compile(a_rules, LocaleRegistry::Get(a_locale).locale_);
+}
+
+/**
+ * @brief Forget all loaded rule sets, they are loaded again when next used; built-in rules are kept.
+ */
+void pg::cpp::utils::SpelloutRules::Reset ()
+{
+    // ... released formatters can't keep their memoized spellouts ...
+    pg::cpp::utils::SpelloutMemo::Reset();
+    (void)s_formats_.EraseIf([] (const Key& a_key, const Format& /* a_format */) -> bool {
+        return false == a_key.first.empty();
+    });
+    s_names_.clear();
+}
+
+/**
+ * @brief Compile RBNF text.
+ *
+ * @param a_rules
+ * @param a_locale
+ *
+ * @throw
+ */
+pg::cpp::utils::SpelloutRules::Format pg::cpp::utils::SpelloutRules::Compile (const pg::cpp::utils::StringView& a_rules, const U_ICU_NAMESPACE::Locale& a_locale)
+{
+    UErrorCode  icu_error_code  = U_ZERO_ERROR;
+    UParseError icu_parse_error;
+
+    Format format(new U_ICU_NAMESPACE::RuleBasedNumberFormat(
+        U_ICU_NAMESPACE::UnicodeString::fromUTF8(U_ICU_NAMESPACE::StringPiece(a_rules.Data(), static_cast<int32_t>(a_rules.Length()))),
+        a_locale, icu_parse_error, icu_error_code
+    ));
+    if ( U_FAILURE(icu_error_code) ) {
+        throw PG_CPP_UTILS_EXCEPTION("Invalid spellout rules, %s at line %d offset %d",
+                                     u_errorName(icu_error_code), icu_parse_error.line, icu_parse_error.offset);
+    }
+
+    return format;
+}
+
+/**
+ * @brief Keep a formatter.
+ *
+ * @remarks It's size is a rough estimate, a dozen bytes per character of it's rules.
+ *
+ * @param a_key
+ * @param a_format
+ *
+ * @return Formatter shared with the cache.
+ */
+pg::cpp::utils::SpelloutRules::Format pg::cpp::utils::SpelloutRules::Insert (const pg::cpp::utils::SpelloutRules::Key& a_key,
+                                                                              pg::cpp::utils::SpelloutRules::Format&& a_format)
+{
+    const size_t bytes = a_key.first.length() + sizeof(U_ICU_NAMESPACE::RuleBasedNumberFormat)
+                       + 12 * static_cast<size_t>(a_format->getRules().length());
+    return s_formats_.Insert(a_key, std::move(a_format), bytes);
+}
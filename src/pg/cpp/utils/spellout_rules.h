@@ -0,0 +1,108 @@
+/**
+ * @file spellout_rules.h
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef PG_CPP_UTILS_SPELLOUT_RULES_H_
+#define PG_CPP_UTILS_SPELLOUT_RULES_H_
+
+#include "pg/cpp/utils/string_view.h"
+#include "pg/cpp/utils/locale_registry.h"
+#include "pg/cpp/utils/status.h"
+#include "pg/cpp/utils/cache.h"
+
+#include <string>  // std::string
+#include <vector>  // std::vector
+#include <map>     // std::map
+#include <utility> // std::pair
+#include <memory>  // std::shared_ptr
+
+#include <unicode/rbnf.h> // ICU RuleBasedNumberFormat
+
+namespace pg
+{
+
+    namespace cpp
+    {
+
+        namespace utils
+        {
+
+            /**
+             * @brief Backend wide cache of spellout formatters: named rule sets ( pg_cpp_utils_spellout_rules rows ), each
+             *        compiled once per locale on first use instead of shipping and parsing the RBNF text on every call, and
+             *        ICU's built-in spellout rules per locale.
+             *
+             * @remarks Rule sets are kept until their table changes, compiled formatters are a \link Cache \link.
+             */
+            class SpelloutRules final
+            {
+
+            public: // Data Type(s)
+
+                typedef std::pair<StringView, StringView> Definition; // locale, rules
+
+                typedef std::shared_ptr<U_ICU_NAMESPACE::RuleBasedNumberFormat> Format;
+
+            private: // Data Type(s)
+
+                typedef std::map<LocaleRegistry::Id, std::string> Locales; // rules
+
+                typedef std::pair<std::string, LocaleRegistry::Id> Key; // name, empty for built-in rules, and rules locale
+
+                struct KeyHash
+                {
+                    size_t operator() (const Key& a_key) const;
+                };
+
+                struct Release
+                {
+                    void operator() (const Key& a_key, const Format& a_format) const;
+                };
+
+            private: // Static Data
+
+                static std::map<std::string, Locales>          s_names_;
+                static LRUCache<Key, Format, KeyHash, Release> s_formats_;
+
+            public: // Static Method(s) / Function(s)
+
+                static bool   IsName   (const StringView& a_override);
+                static bool   IsLoaded (const StringView& a_name);
+                static void   Load     (const StringView& a_name, const std::vector<Definition>& a_definitions);
+                static Format Get      (const StringView& a_name, const LocaleRegistry::Entry& a_locale, Status& o_status);
+                static Format BuiltIn  (const LocaleRegistry::Entry& a_locale, Status& o_status);
+                static void   Validate (const StringView& a_locale, const StringView& a_rules);
+                static void   Reset    ();
+
+            private: // Static Method(s) / Function(s)
+
+                static Format Compile (const StringView& a_rules, const U_ICU_NAMESPACE::Locale& a_locale);
+                static Format Insert  (const Key& a_key, Format&& a_format);
+
+            }; // end of class 'SpelloutRules'
+
+        } // end of namespace 'utils'
+
+    } // end of namespace 'cpp'
+
+} // end of namespace 'pg'
+
+#endif // PG_CPP_UTILS_SPELLOUT_RULES_H_
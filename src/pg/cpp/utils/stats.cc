@@ -0,0 +1,306 @@
+/**
+ * @file stats.cc
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pg/cpp/utils/stats.h"
+
+#include "pg/cpp/utils/exception.h"
+
+extern "C" {
+    #include "miscadmin.h"      // process_shared_preload_libraries_in_progress
+    #include "storage/ipc.h"    // shmem_startup_hook
+    #include "storage/shmem.h"  // ShmemInitStruct
+    #include "storage/lwlock.h" // AddinShmemInitLock
+    #include "port/atomics.h"
+}
+
+#include <inttypes.h> // PRIu64
+
+/**
+ * @brief Cluster wide counters, only available when loaded via shared_preload_libraries.
+ */
+struct pg::cpp::utils::Stats::Shared
+{
+    struct {
+        pg_atomic_uint64 calls_;
+        pg_atomic_uint64 errors_;
+        pg_atomic_uint64 total_us_;
+        pg_atomic_uint64 max_us_;
+        pg_atomic_uint64 cache_hits_;
+        pg_atomic_uint64 cache_misses_;
+    } counters_[static_cast<size_t>(pg::cpp::utils::Stats::Function::Count)];
+};
+
+pg::cpp::utils::Stats::Counters pg::cpp::utils::Stats::s_local_[static_cast<size_t>(pg::cpp::utils::Stats::Function::Count)];
+pg::cpp::utils::Stats::Shared*  pg::cpp::utils::Stats::s_shared_  = nullptr;
+pg::cpp::utils::Stats::Function pg::cpp::utils::Stats::s_current_ = pg::cpp::utils::Stats::Function::Count;
+
+static shmem_startup_hook_type s_previous_shmem_startup_hook_ = nullptr;
+#if PG_VERSION_NUM >= 150000
+static shmem_request_hook_type s_previous_shmem_request_hook_ = nullptr;
+#endif
+
+/**
+ * @brief Default constructor.
+ */
+pg::cpp::utils::Stats::Stats ()
+{
+    memset(counters_, 0, sizeof(counters_));
+}
+
+/**
+ * @brief Destructor.
+ */
+pg::cpp::utils::Stats::~Stats ()
+{
+    /* empty */
+}
+
+/**
+ * @brief Fill user provided context information, one record per function.
+ *
+ * @param a_context
+ */
+void pg::cpp::utils::Stats::FillOutputAtUserFuncContext (FuncCallContext* a_context)
+{
+    Utility::Records* records = Utility::UserFuncContextRecords(a_context);
+    for ( size_t idx = 0 ; idx < static_cast<size_t>(Function::Count) ; ++idx ) {
+        const Counters& counters = counters_[idx];
+        const double    mean_us  = counters.calls_ > 0 ? static_cast<double>(counters.total_us_) / counters.calls_ : 0.0;
+        char**          values   = records->Append(8);
+        values[0] = records->Copy(Name(static_cast<Function>(idx)));
+        values[1] = records->Format("%" PRIu64, counters.calls_);
+        values[2] = records->Format("%" PRIu64, counters.errors_);
+        values[3] = records->Format("%" PRIu64, counters.total_us_);
+        values[4] = records->Format("%" PRIu64, counters.max_us_);
+        values[5] = records->Format("%f", mean_us);
+        values[6] = records->Format("%" PRIu64, counters.cache_hits_);
+        values[7] = records->Format("%" PRIu64, counters.cache_misses_);
+        a_context->max_calls += 1;
+    }
+}
+
+/**
+ * @brief Take a snapshot of this backend, or cluster wide, counters.
+ *
+ * @param a_shared
+ *
+ * @throw
+ */
+void pg::cpp::utils::Stats::Collect (const bool a_shared)
+{
+    if ( false == a_shared ) {
+        memcpy(counters_, s_local_, sizeof(counters_));
+        return;
+    }
+
+    if ( nullptr == s_shared_ ) {
+        throw PG_CPP_UTILS_EXCEPTION_NA("Cluster wide statistics require pg-cpp-utils to be loaded via shared_preload_libraries!");
+    }
+
+    for ( size_t idx = 0 ; idx < static_cast<size_t>(Function::Count) ; ++idx ) {
+        counters_[idx].calls_        = pg_atomic_read_u64(&s_shared_->counters_[idx].calls_);
+        counters_[idx].errors_       = pg_atomic_read_u64(&s_shared_->counters_[idx].errors_);
+        counters_[idx].total_us_     = pg_atomic_read_u64(&s_shared_->counters_[idx].total_us_);
+        counters_[idx].max_us_       = pg_atomic_read_u64(&s_shared_->counters_[idx].max_us_);
+        counters_[idx].cache_hits_   = pg_atomic_read_u64(&s_shared_->counters_[idx].cache_hits_);
+        counters_[idx].cache_misses_ = pg_atomic_read_u64(&s_shared_->counters_[idx].cache_misses_);
+    }
+}
+
+/**
+ * @brief Module load time setup, shared memory is only requested when preloaded.
+ */
+void pg::cpp::utils::Stats::Startup ()
+{
+    memset(s_local_, 0, sizeof(s_local_));
+
+    if ( false == process_shared_preload_libraries_in_progress ) {
+        return;
+    }
+
+#if PG_VERSION_NUM >= 150000
+    s_previous_shmem_request_hook_ = shmem_request_hook;
+    shmem_request_hook             = RequestSharedMemory;
+#else
+    RequestSharedMemory();
+#endif
+    s_previous_shmem_startup_hook_ = shmem_startup_hook;
+    shmem_startup_hook             = StartupSharedMemory;
+}
+
+/**
+ * @brief Mark the start of a function call, so cache hits / misses can be attributed to it.
+ *
+ * @param a_function
+ */
+void pg::cpp::utils::Stats::Begin (const pg::cpp::utils::Stats::Function a_function)
+{
+    s_current_ = a_function;
+}
+
+/**
+ * @brief Account a function call.
+ *
+ * @param a_function
+ * @param a_elapsed_us
+ * @param a_failed
+ */
+void pg::cpp::utils::Stats::End (const pg::cpp::utils::Stats::Function a_function, const uint64_t a_elapsed_us, const bool a_failed)
+{
+    const size_t idx = static_cast<size_t>(a_function);
+
+    s_local_[idx].calls_    += 1;
+    s_local_[idx].errors_   += ( a_failed ? 1 : 0 );
+    s_local_[idx].total_us_ += a_elapsed_us;
+    if ( a_elapsed_us > s_local_[idx].max_us_ ) {
+        s_local_[idx].max_us_ = a_elapsed_us;
+    }
+
+    if ( nullptr != s_shared_ ) {
+        pg_atomic_fetch_add_u64(&s_shared_->counters_[idx].calls_, 1);
+        if ( true == a_failed ) {
+            pg_atomic_fetch_add_u64(&s_shared_->counters_[idx].errors_, 1);
+        }
+        pg_atomic_fetch_add_u64(&s_shared_->counters_[idx].total_us_, static_cast<int64>(a_elapsed_us));
+        uint64 max_us = pg_atomic_read_u64(&s_shared_->counters_[idx].max_us_);
+        while ( a_elapsed_us > max_us && false == pg_atomic_compare_exchange_u64(&s_shared_->counters_[idx].max_us_, &max_us, a_elapsed_us) ) {
+            /* max_us was refreshed, retry */
+        }
+    }
+
+    s_current_ = Function::Count;
+}
+
+/**
+ * @brief Account a cache hit for the function being called.
+ */
+void pg::cpp::utils::Stats::CacheHit ()
+{
+    if ( Function::Count == s_current_ ) {
+        return;
+    }
+    const size_t idx = static_cast<size_t>(s_current_);
+    s_local_[idx].cache_hits_ += 1;
+    if ( nullptr != s_shared_ ) {
+        pg_atomic_fetch_add_u64(&s_shared_->counters_[idx].cache_hits_, 1);
+    }
+}
+
+/**
+ * @brief Account a cache miss for the function being called.
+ */
+void pg::cpp::utils::Stats::CacheMiss ()
+{
+    if ( Function::Count == s_current_ ) {
+        return;
+    }
+    const size_t idx = static_cast<size_t>(s_current_);
+    s_local_[idx].cache_misses_ += 1;
+    if ( nullptr != s_shared_ ) {
+        pg_atomic_fetch_add_u64(&s_shared_->counters_[idx].cache_misses_, 1);
+    }
+}
+
+/**
+ * @return The SQL function name, without the 'pg_cpp_utils_' prefix.
+ *
+ * @param a_function
+ */
+const char* pg::cpp::utils::Stats::Name (const pg::cpp::utils::Stats::Function a_function)
+{
+    switch ( a_function ) {
+        case Function::Version:
+            return "version";
+        case Function::InvoiceHash:
+            return "invoice_hash";
+        case Function::InvoiceHashBatch:
+            return "invoice_hash_batch";
+        case Function::InvoiceHashVerify:
+            return "invoice_hash_verify";
+        case Function::InvoiceHashVerifyBatch:
+            return "invoice_hash_verify_batch";
+        case Function::Sign:
+            return "sign";
+        case Function::SignVerify:
+            return "sign_verify";
+        case Function::PublicLink:
+            return "public_link";
+        case Function::NumberSpellout:
+            return "number_spellout";
+        case Function::NumberSpelloutBatch:
+            return "number_spellout_batch";
+        case Function::CurrencySpellout:
+            return "currency_spellout";
+        case Function::FormatNumber:
+            return "format_number";
+        case Function::FormatMessage:
+            return "format_message";
+        case Function::FormatMessageTyped:
+            return "format_message_typed";
+        case Function::Bench:
+            return "bench";
+        case Function::Stats:
+            return "stats";
+        case Function::Caches:
+            return "caches";
+        default:
+            return "???";
+    }
+}
+
+/**
+ * @brief Reserve cluster wide counters space.
+ */
+void pg::cpp::utils::Stats::RequestSharedMemory ()
+{
+#if PG_VERSION_NUM >= 150000
+    if ( nullptr != s_previous_shmem_request_hook_ ) {
+        s_previous_shmem_request_hook_();
+    }
+#endif
+    RequestAddinShmemSpace(MAXALIGN(sizeof(pg::cpp::utils::Stats::Shared)));
+}
+
+/**
+ * @brief Attach to ( or create and initialize ) cluster wide counters.
+ */
+void pg::cpp::utils::Stats::StartupSharedMemory ()
+{
+    if ( nullptr != s_previous_shmem_startup_hook_ ) {
+        s_previous_shmem_startup_hook_();
+    }
+
+    bool found = false;
+
+    LWLockAcquire(AddinShmemInitLock, LW_EXCLUSIVE);
+    s_shared_ = static_cast<pg::cpp::utils::Stats::Shared*>(ShmemInitStruct("pg-cpp-utils stats", sizeof(pg::cpp::utils::Stats::Shared), &found));
+    if ( false == found ) {
+        for ( size_t idx = 0 ; idx < static_cast<size_t>(Function::Count) ; ++idx ) {
+            pg_atomic_init_u64(&s_shared_->counters_[idx].calls_       , 0);
+            pg_atomic_init_u64(&s_shared_->counters_[idx].errors_      , 0);
+            pg_atomic_init_u64(&s_shared_->counters_[idx].total_us_    , 0);
+            pg_atomic_init_u64(&s_shared_->counters_[idx].max_us_      , 0);
+            pg_atomic_init_u64(&s_shared_->counters_[idx].cache_hits_  , 0);
+            pg_atomic_init_u64(&s_shared_->counters_[idx].cache_misses_, 0);
+        }
+    }
+    LWLockRelease(AddinShmemInitLock);
+}
@@ -0,0 +1,127 @@
+/**
+ * @file stats.h
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef PG_CPP_UTILS_STATS_H_
+#define PG_CPP_UTILS_STATS_H_
+
+#include "pg/cpp/utils/utility.h"
+
+#include <string> // std::string
+
+namespace pg
+{
+
+    namespace cpp
+    {
+
+        namespace utils
+        {
+
+            class Stats final : public Utility
+            {
+
+            public: // Data Type(s)
+
+                /**
+                 * @brief SQL functions being accounted, see \link Name \link.
+                 */
+                enum class Function : uint8_t
+                {
+                    Version = 0,
+                    InvoiceHash,
+                    InvoiceHashBatch,
+                    InvoiceHashVerify,
+                    InvoiceHashVerifyBatch,
+                    Sign,
+                    SignVerify,
+                    PublicLink,
+                    NumberSpellout,
+                    NumberSpelloutBatch,
+                    CurrencySpellout,
+                    FormatNumber,
+                    FormatMessage,
+                    FormatMessageTyped,
+                    Bench,
+                    Stats,
+                    Caches,
+                    Count
+                };
+
+                typedef struct {
+                    uint64_t calls_;
+                    uint64_t errors_;
+                    uint64_t total_us_;
+                    uint64_t max_us_;
+                    uint64_t cache_hits_;
+                    uint64_t cache_misses_;
+                } Counters;
+
+            private: // Data Type(s)
+
+                struct Shared;
+
+            private: // Static Data
+
+                static Counters s_local_[static_cast<size_t>(Function::Count)];
+                static Shared*  s_shared_;
+                static Function s_current_;
+
+            private: // Data
+
+                Counters counters_[static_cast<size_t>(Function::Count)];
+
+            public: // Constructor / Destructor.
+
+                Stats ();
+                virtual ~Stats();
+
+            public: // Inherited Pure Virtual Method(s) / Function(s)
+
+                virtual void FillOutputAtUserFuncContext (FuncCallContext* a_context);
+
+            public: // Method(s) / Function(s)
+
+                void Collect (const bool a_shared);
+
+            public: // Static Method(s) / Function(s)
+
+                static void        Startup   ();
+                static void        Begin     (const Function a_function);
+                static void        End       (const Function a_function, const uint64_t a_elapsed_us, const bool a_failed);
+                static void        CacheHit  ();
+                static void        CacheMiss ();
+                static const char* Name      (const Function a_function);
+
+            private: // Static Method(s) / Function(s)
+
+                static void RequestSharedMemory ();
+                static void StartupSharedMemory ();
+
+            }; // end of class 'Stats'
+
+        } // end of namespace 'utils'
+
+    } // end of namespace 'cpp'
+
+} // end of namespace 'pg'
+
+#endif // PG_CPP_UTILS_STATS_H_
@@ -0,0 +1,154 @@
+/**
+ * @file status.h
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#ifndef PG_CPP_UTILS_STATUS_H_
+#define PG_CPP_UTILS_STATUS_H_
+
+#include <stdarg.h> // va_list
+#include <stdio.h>  // vsnprintf
+
+#include <string> // std::string
+
+namespace pg
+{
+
+    namespace cpp
+    {
+
+        namespace utils
+        {
+
+            /**
+             * @brief Outcome of a utility call, the hot path alternative to throwing an \link Exception \link.
+             *
+             * @remarks Only failures pay for formatting; the message buffer is kept and reused between calls.
+             */
+            class Status final
+            {
+
+            private: // Data
+
+                bool        failed_;
+                std::string message_;
+
+            public: // Constructor(s) / Destructor
+
+                Status ()
+                    : failed_(false)
+                {
+                    /* empty */
+                }
+
+            public: // Method(s) / Function(s)
+
+                bool Fail (const char* const a_format, ...) __attribute__((format(printf, 2, 3)));
+
+                /**
+                 * @brief Forget a previous failure.
+                 */
+                inline void Reset ()
+                {
+                    failed_ = false;
+                    message_.clear();
+                }
+
+                /**
+                 * @return True if \link Fail \link was called since the last \link Reset \link.
+                 */
+                inline bool Failed () const
+                {
+                    return failed_;
+                }
+
+                /**
+                 * @return Failure message, empty on success.
+                 */
+                inline const std::string& Message () const
+                {
+                    return message_;
+                }
+
+            public: // Static Method(s) / Function(s)
+
+                static void Format (std::string& o_string, const char* const a_format, va_list a_args);
+
+            }; // end of class 'Status'
+
+            /**
+             * @brief Record a failure.
+             *
+             * @param a_format printf like format followed by a variable number of arguments.
+             * @param ...
+             *
+             * @return Always false, so callers can 'return status_.Fail(...)'.
+             */
+            inline bool Status::Fail (const char* const a_format, ...)
+            {
+                va_list args;
+
+                va_start(args, a_format);
+                Format(message_, a_format, args);
+                va_end(args);
+
+                failed_ = true;
+
+                return false;
+            }
+
+            /**
+             * @brief printf like formatting into a string, shared by \link Status \link and \link ErrorBridge::Error \link.
+             *
+             * @param o_string Replaced by the formatted text, or by \p a_format if it can't be formatted.
+             * @param a_format
+             * @param a_args   Not consumed, the caller still owns it.
+             *
+             * @remarks Short texts are formatted on the stack, longer ones cost a single exactly sized retry.
+             */
+            inline void Status::Format (std::string& o_string, const char* const a_format, va_list a_args)
+            {
+                char    buffer[256];
+                va_list args;
+
+                va_copy(args, a_args);
+                const int length = vsnprintf(buffer, sizeof(buffer), a_format, args);
+                va_end(args);
+
+                if ( length < 0 ) {
+                    o_string = a_format;
+                } else if ( static_cast<size_t>(length) < sizeof(buffer) ) {
+                    o_string.assign(buffer, static_cast<size_t>(length));
+                } else {
+                    // ... at most one retry, sized exactly ...
+                    o_string.resize(static_cast<size_t>(length) + 1);
+                    va_copy(args, a_args);
+                    (void)vsnprintf(&o_string[0], o_string.size(), a_format, args);
+                    va_end(args);
+                    o_string.resize(static_cast<size_t>(length));
+                }
+            }
+
+        } // end of namespace 'utils'
+
+    } // end of namespace 'cpp'
+
+} // end of namespace 'pg'
+
+#endif // PG_CPP_UTILS_STATUS_H_
@@ -0,0 +1,172 @@
+/**
+ * @file string_view.h
+ *
+ *
+ * Copyright (c) 2011-2018 Cloudware S.A. All rights reserved.
+ *
+ * This file is part of casper-pg-cpp-utils.
+ *
+ * casper-pg-cpp-utils is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * casper-pg-cpp-utils is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with casper.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef PG_CPP_UTILS_STRING_VIEW_H_
+#define PG_CPP_UTILS_STRING_VIEW_H_
+
+#include <stddef.h> // size_t
+#include <string.h> // strlen, memcmp, memcpy
+
+#include <string> // std::string
+
+namespace pg
+{
+
+    namespace cpp
+    {
+
+        namespace utils
+        {
+
+            /**
+             * @brief Non-owning, not NUL terminated, view of a character sequence - e.g. the VARDATA_ANY of a text argument.
+             *
+             * @remarks The viewed memory must outlive the view.
+             */
+            class StringView final
+            {
+
+            private: // Data
+
+                const char* data_;
+                size_t      length_;
+
+            public: // Constructor(s) / Destructor
+
+                StringView ()
+                    : data_(""), length_(0)
+                {
+                    /* empty */
+                }
+
+                StringView (const char* a_data, const size_t a_length)
+                    : data_(a_data), length_(a_length)
+                {
+                    /* empty */
+                }
+
+                StringView (const char* a_c_str)
+                    : data_(a_c_str), length_(strlen(a_c_str))
+                {
+                    /* empty */
+                }
+
+                StringView (const std::string& a_string)
+                    : data_(a_string.c_str()), length_(a_string.length())
+                {
+                    /* empty */
+                }
+
+            public: // Method(s) / Function(s)
+
+                inline const char* Data       () const;
+                inline size_t      Length     () const;
+                inline bool        Empty      () const;
+                inline bool        Equals     (const StringView& a_other) const;
+                inline bool        StartsWith (const StringView& a_prefix) const;
+                inline bool        CopyTo     (char* o_buffer, const size_t a_size) const;
+                inline std::string ToString   () const;
+
+            }; // end of class 'StringView'
+
+            /**
+             * @return Pointer to the first character, not NUL terminated.
+             */
+            inline const char* StringView::Data () const
+            {
+                return data_;
+            }
+
+            /**
+             * @return Length in bytes.
+             */
+            inline size_t StringView::Length () const
+            {
+                return length_;
+            }
+
+            /**
+             * @return True if the length is 0.
+             */
+            inline bool StringView::Empty () const
+            {
+                return 0 == length_;
+            }
+
+            /**
+             * @return True if both views have the same bytes.
+             *
+             * @param a_other
+             */
+            inline bool StringView::Equals (const StringView& a_other) const
+            {
+                return length_ == a_other.length_ && 0 == memcmp(data_, a_other.data_, length_);
+            }
+
+            /**
+             * @return True if this view starts with a prefix.
+             *
+             * @param a_prefix
+             */
+            inline bool StringView::StartsWith (const StringView& a_prefix) const
+            {
+                return length_ >= a_prefix.length_ && 0 == memcmp(data_, a_prefix.data_, a_prefix.length_);
+            }
+
+            /**
+             * @brief Copy to a NUL terminated buffer, e.g. a stack buffer for APIs that need a C string.
+             *
+             * @param o_buffer
+             * @param a_size   Buffer size, including the NUL terminator.
+             *
+             * @return False if the view does not fit, the buffer is left empty.
+             */
+            inline bool StringView::CopyTo (char* o_buffer, const size_t a_size) const
+            {
+                if ( 0 == a_size ) {
+                    return false;
+                }
+                if ( length_ >= a_size ) {
+                    o_buffer[0] = '\0';
+                    return false;
+                }
+                memcpy(o_buffer, data_, length_);
+                o_buffer[length_] = '\0';
+                return true;
+            }
+
+            /**
+             * @return An owning copy.
+             */
+            inline std::string StringView::ToString () const
+            {
+                return std::string(data_, length_);
+            }
+
+        } // end of namespace 'utils'
+
+    } // end of namespace 'cpp'
+
+} // end of namespace 'pg'
+
+#endif // PG_CPP_UTILS_STRING_VIEW_H_
@@ -21,28 +21,123 @@
 
 #include "pg/cpp/utils/utility.h"
 
+#include <new>      // placement new
+#include <stdarg.h> // va_list, va_start, va_end
+#include <stdio.h>  // vsnprintf
+#include <string.h> // memcpy
+
+/**
+ * @brief Default constructor.
+ *
+ * @param a_context Memory context that will own all records data.
+ */
+pg::cpp::utils::Utility::Records::Records (MemoryContext a_context)
+    : context_(a_context), rows_(nullptr), count_(0), capacity_(0)
+{
+    /* empty */
+}
+
+/**
+ * @brief Append a new record, all values are set to nullptr.
+ *
+ * @param a_columns Number of values.
+ *
+ * @return The record values array, to be filled with \link Copy \link or \link Format \link.
+ */
+char** pg::cpp::utils::Utility::Records::Append (const size_t a_columns)
+{
+    if ( count_ == capacity_ ) {
+        const size_t capacity = ( 0 == capacity_ ? 4 : capacity_ * 2 );
+        if ( nullptr == rows_ ) {
+            rows_ = (char***)MemoryContextAlloc(context_, sizeof(char**) * capacity);
+        } else {
+            rows_ = (char***)repalloc(rows_, sizeof(char**) * capacity);
+        }
+        capacity_ = capacity;
+    }
+    char** row = (char**)MemoryContextAlloc(context_, sizeof(char*) * a_columns);
+    for ( size_t idx = 0 ; idx < a_columns ; ++idx ) {
+        row[idx] = nullptr;
+    }
+    rows_[count_++] = row;
+    return row;
+}
+
+/**
+ * @brief Append a new record, copying it's values.
+ *
+ * @param a_values
+ */
+void pg::cpp::utils::Utility::Records::Append (const std::initializer_list<const char*> a_values)
+{
+    char** row = Append(a_values.size());
+    size_t idx = 0;
+    for ( auto value : a_values ) {
+        row[idx++] = ( nullptr != value ? Copy(value, strlen(value)) : nullptr );
+    }
+}
+
+/**
+ * @brief Copy a string to the records memory context.
+ *
+ * @param a_value
+ * @param a_length
+ */
+char* pg::cpp::utils::Utility::Records::Copy (const char* const a_value, const size_t a_length)
+{
+    char* rv = (char*)MemoryContextAlloc(context_, a_length + sizeof(char));
+    memcpy(rv, a_value, a_length);
+    rv[a_length] = '\0';
+    return rv;
+}
+
+/**
+ * @brief Write a formatted string to the records memory context.
+ *
+ * @param a_format
+ * @param ...
+ */
+char* pg::cpp::utils::Utility::Records::Format (const char* const a_format, ...)
+{
+    char    buffer[64];
+    va_list args;
+    va_start(args, a_format);
+    const int length = vsnprintf(buffer, sizeof(buffer), a_format, args);
+    va_end(args);
+    if ( length < 0 ) {
+        return nullptr;
+    }
+    if ( static_cast<size_t>(length) < sizeof(buffer) ) {
+        return Copy(buffer, static_cast<size_t>(length));
+    }
+    char* rv = (char*)MemoryContextAlloc(context_, static_cast<size_t>(length) + sizeof(char));
+    va_start(args, a_format);
+    vsnprintf(rv, static_cast<size_t>(length) + sizeof(char), a_format, args);
+    va_end(args);
+    return rv;
+}
+
 /**
- * @brief Allocate user context information.
+ * @brief Allocate user context information, at the function call memory context.
  *
  * @param a_context
  */
 void pg::cpp::utils::Utility::AllocUserFuncContext (FuncCallContext* a_context)
 {
-    a_context->user_fctx = new pg::cpp::utils::Utility::Records();
+    void* memory = MemoryContextAlloc(a_context->multi_call_memory_ctx, sizeof(pg::cpp::utils::Utility::Records));
+    a_context->user_fctx = new (memory) pg::cpp::utils::Utility::Records(a_context->multi_call_memory_ctx);
     a_context->max_calls = 0;
 }
 
 /**
- * @brief Release user provided context information.
+ * @brief Forget user provided context information.
+ *
+ * @remarks Memory is released along with the function call memory context.
  *
  * @param a_context
  */
 void pg::cpp::utils::Utility::DeallocUserFuncContext (FuncCallContext* a_context)
 {
-    if ( nullptr != a_context->user_fctx ) {
-        pg::cpp::utils::Utility::Records* records = static_cast<pg::cpp::utils::Utility::Records*>(a_context->user_fctx);
-        delete records;
-        a_context->user_fctx = nullptr;
-        a_context->max_calls = 0;
-    }
+    a_context->user_fctx = nullptr;
+    a_context->max_calls = 0;
 }
@@ -25,8 +25,10 @@
 
 #include "pg/postgres.h"
 
+#include "pg/cpp/utils/status.h"
+
 #include <string>
-#include <vector>
+#include <initializer_list>
 
 namespace pg
 {
@@ -42,120 +44,85 @@ namespace pg
 
             public: // Data Type(s)
 
-                class Record
-                {
-
-                public: // Constructor / Destructor
-
-                    /**
-                     * @brief Destructor.
-                     */
-                    virtual ~Record ()
-                    {
-                        /* empty */
-                    }
-
-                public: // Method(s) / Function(s)
-
-                    /**
-                     * @brief Allocate memory from postgres pool and copy a string.
-                     *
-                     * @param a_value.
-                     */
-                    inline char* PCopyString (const char* const a_value)
-                    {
-                        if ( nullptr == a_value ) {
-                            return nullptr;
-                        }
-                        const size_t length = sizeof(char) * ( strlen(a_value) + sizeof(char) );
-                        char* rv = (char*)palloc(length);
-                        if ( nullptr != rv ) {
-                            rv[0] = '\0';
-                            snprintf(rv, length, "%s", a_value);
-                        }
-                        return rv;
-                    }
-
-                public: // Pure Virtual Method(s) / Function(s) - declaration
-
-                    /**
-                     * @brief Allocate memory from postgres pool and copy a record data to it.
-                     *
-                     * @return An array of string representing a record.
-                     */
-                    virtual char** PStringValues () = 0;
-
-                };
-
                 /**
                  * A class that holds a calculation results.
+                 *
+                 * Rows and values are allocated from the function call memory context ( multi_call_memory_ctx ),
+                 * they are released in bulk by postgres when the context is deleted - no per row C++ heap traffic
+                 * and nothing leaks if an ereport longjmps past the C++ destructors.
                  */
-                class Records
+                class Records final
                 {
 
-                protected: // Data
+                private: // Data
 
-                    std::vector<Record*> items_;
+                    MemoryContext context_;
+                    char***       rows_;
+                    size_t        count_;
+                    size_t        capacity_;
 
                 public: // Constructor / Destructor
 
+                    Records (MemoryContext a_context);
+                    Records (const Records&) = delete;
+                    Records& operator = (const Records&) = delete;
+
                     /**
-                     * @brief Default constructor.
+                     * @brief Destructor, memory is owned by the memory context.
                      */
-                    Records ()
+                    ~Records ()
                     {
                         /* empty */
                     }
 
+                public: // Method(s) / Function(s)
+
+                    char** Append (const size_t a_columns);
+                    void   Append (const std::initializer_list<const char*> a_values);
+                    char*  Copy   (const char* const a_value, const size_t a_length);
+                    char*  Format (const char* const a_format, ...) __attribute__((format(printf, 2, 3)));
+
                     /**
-                     * @brief Destructor.
+                     * @brief Copy a null terminated string to the records memory context.
+                     *
+                     * @param a_value
                      */
-                    virtual ~Records ()
+                    inline char* Copy (const char* const a_value)
                     {
-                        for ( auto record : items_ ) {
-                            if ( nullptr != record ) {
-                                delete record;
-                            }
-                        }
+                        return Copy(a_value, strlen(a_value));
                     }
 
-                public:
-
                     /**
-                     * @brief Push back a record ( it's memory will be owned by this object ).
+                     * @brief Copy a string to the records memory context.
                      *
-                     * @param a_record
+                     * @param a_value
                      */
-                    inline void Append (Record* a_record)
+                    inline char* Copy (const std::string& a_value)
                     {
-                        items_.push_back(a_record);
+                        return Copy(a_value.c_str(), a_value.length());
                     }
 
                     /**
-                     * @brief Release a previously allocated object at a specific position.
-                     *
-                     * @param a_index Record position within the internal array.
-                     * @param a_values
+                     * @return Number of appended records.
                      */
-                    inline void Release (const size_t a_index, char** a_values)
+                    inline size_t Count () const
                     {
-                        if ( nullptr != items_[a_index] ) {
-                            delete items_[a_index];
-                            items_[a_index] = nullptr;
-                        }
+                        return count_;
                     }
 
                     /**
-                     * @brief Allocate memory from postgres pool and copy a record data to it.
+                     * @brief Access a record values.
                      *
                      * @param a_index Record position within the internal array.
+                     *
+                     * @return An array of strings representing a record, nullptr if out of bounds.
                      */
-                    virtual char** GetPStringValues (const size_t a_index)
+                    inline char** Values (const size_t a_index) const
                     {
-                        if ( a_index >= items_.size() ) {
+                        if ( a_index >= count_ ) {
                             return nullptr;
                         }
-                        return items_[a_index]->PStringValues();
+                        return rows_[a_index];
                     }
 
                 };
@@ -172,26 +139,54 @@ namespace pg
 
             protected: // Data
 
-                std::string error_;
+                Status status_;
 
             public: // Pure Virtual Method(s) / Function(s)
 
                 virtual void FillOutputAtUserFuncContext (FuncCallContext* a_context) = 0;
 
+            public: // Virtual Method(s) / Function(s)
+
+                /**
+                 * @brief Produce the next record of a streamed ( value-per-call or materialized ) result.
+                 *
+                 * @param a_records Where to append exactly one record.
+                 *
+                 * @return False when there are no more records.
+                 */
+                virtual bool Next (Records& /* a_records */)
+                {
+                    return false;
+                }
+
             public: // Method(s) / Function(s)
 
-                const std::string& LastError () const;
+                const Status& LastStatus () const;
 
             public: // Static Method(s) / Function(s)
 
-                static void AllocUserFuncContext   (FuncCallContext* a_context);
-                static void DeallocUserFuncContext (FuncCallContext* a_context);
+                static void     AllocUserFuncContext   (FuncCallContext* a_context);
+                static void     DeallocUserFuncContext (FuncCallContext* a_context);
+                static Records* UserFuncContextRecords (FuncCallContext* a_context);
 
             }; // end of class Utility
 
-            inline const std::string& Utility::LastError () const
+            /**
+             * @return Outcome of the last call, failures are reported by the caller - utilities do not throw on the hot path.
+             */
+            inline const Status& Utility::LastStatus () const
+            {
+                return status_;
+            }
+
+            /**
+             * @brief Access records stored at user context information.
+             *
+             * @param a_context
+             */
+            inline Utility::Records* Utility::UserFuncContextRecords (FuncCallContext* a_context)
             {
-                return error_;
+                return static_cast<Utility::Records*>(a_context->user_fctx);
             }
 
         } // end of namespace 'utils'
@@ -45,7 +45,7 @@ pg::cpp::utils::Version::~Version ()
  */
 void pg::cpp::utils::Version::FillOutputAtUserFuncContext (FuncCallContext* a_context)
 {
-    Utility::Records* records = static_cast<Utility::Records*>(a_context->user_fctx);
-    records->Append(new pg::cpp::utils::Version::Record(PG_CPP_UTILS_VERSION));
+    Utility::Records* records = Utility::UserFuncContextRecords(a_context);
+    records->Append({ PG_CPP_UTILS_VERSION });
     a_context->max_calls += 1;
 }
@@ -39,66 +39,6 @@ namespace pg
             class Version final : public Utility
             {
 
-            public: // Data Type(s)
-
-                class Record final : public Utility::Record
-                {
-
-                public: // Const Data
-
-                    const std::string short_;
-
-                private: // Data
-
-                    char** p_string_values_;
-
-                public: // Constructor / Destructor
-
-                    /**
-                     * @brief Default constructor.
-                     *
-                     * @param a_short
-                     */
-                    Record (const std::string& a_short)
-                        : short_(a_short)
-                    {
-                        p_string_values_ = nullptr;
-                    }
-
-                    /**
-                     * @brief Destructor.
-                     */
-                    virtual ~Record ()
-                    {
-                        if ( nullptr != p_string_values_ ) {
-                            if ( nullptr != p_string_values_[0] ) {
-                                pfree(p_string_values_[0]);
-                            }
-                            pfree(p_string_values_);
-                        }
-                    }
-
-                public: // Inherited Pure Virtual Method(s) / Function(s) - implementation
-
-                    /**
-                     * @brief Allocate memory from postgres pool and copy a record data to it.
-                     *
-                     * @return An array of string representing a record.
-                     */
-                    virtual char** PStringValues ()
-                    {
-                        char** tmp = (char**)palloc(sizeof(char*)*1);
-                        if ( nullptr == tmp ) {
-                            return nullptr;
-                        }
-
-                        tmp[0] = PCopyString(short_.c_str());
-
-                        return tmp;
-                    }
-
-                }; // end of 'Record' class
-
             private: // Data
 
                 std::string short_;